@@ -2,18 +2,32 @@
 #include <queue>
 #include <io.h>	
 #include <tuple>
+#include <memory>
+#include <thread>
+#include <climits>
 
 #include <opencv2/core.hpp>
 #include <opencv2/opencv.hpp>
 #include <opencv2/imgproc.hpp>
+#include <opencv2/core/hal/intrin.hpp>
 #include <algorithm>
 
 
 #include "InBoxChecker_Tool.hpp"
+#include "ThreadPool_Tool.hpp"
 
 
 class ColorDetection
 {
+public:
+	struct ColorDetectionResult
+	{
+		std::string Name;
+		int DetectedPixelCount;
+		std::vector<cv::Rect> Boxes;
+	};
+	enum eMedianEngine { Median_Sort = 0, Median_Histogram = 1 };
+	enum eLabelingEngine { Labeling_FloodFill = 0, Labeling_UnionFind = 1 };
 private:
 	struct meHueDetectionRange
 	{
@@ -33,15 +47,94 @@ private:
 		int mSaturationThreshold;
 
 		std::string mName;
+
+		std::vector<uint8_t> mHueSatTable; // 256x256 mapped values, index = hue * 256 + saturation
+	};
+
+	// Horizontal run of non-zero flag cells, [Start, End] inclusive.
+	// Seed is the first column not covered by an existing box, or -1
+	struct meLabelRun
+	{
+		int Row;
+		int Start;
+		int End;
+		int Seed;
+	};
+	// Runs and local union-find parents of a band of flag rows [RowBegin, RowEnd)
+	struct meLabelStrip
+	{
+		int RowBegin;
+		int RowEnd;
+		std::vector<meLabelRun> Runs;
+		std::vector<int> Parents;
+		int FirstRowRunEnd;
+		int LastRowRunBegin;
+	};
+	// Grid median state of one worker. Histogram engine: per-column histograms over the current window rows
+	// and the histogram of the current window. Sort engine: the window buffer
+	struct meMedianState
+	{
+		std::vector<uint16_t> ColumnHistograms;
+		std::vector<uint16_t> KernelHistogram;
+		int HistogramTop = 0;
+		int HistogramBottom = 0;
+		int KernelLeft = 0;
+		int KernelRight = 0;
+		std::vector<uint8_t> SortBuffer;
+		std::vector<std::pair<int, int>> RowPlan; // (column, flag column) of the grid points of one row
 	};
 
 	std::vector<meHueDetectionRange> mHueDetectionRanges;
 	float colorHueMapping(float mappingValue,const int& curSaturation, meHueDetectionRange* currHueDetectionRange);
+	void makeHueSatTable(meHueDetectionRange* currHueDetectionRange);
+	void mapHueFramesFromBGR(const cv::Mat& BGRFrame, const std::vector<int>& detectionIndices,
+		std::vector<cv::Mat>* hueMappedFrames, cv::Mat* HSVFrame);
+	void resetMedianHistograms(const cv::Mat& frame, meMedianState* state);
+	void beginMedianRow(const cv::Mat& frame, const int& centerRow, const int& half, meMedianState* state);
+	uint8_t getHistogramMedian(const cv::Mat& frame, const int& centerCol, const int& half, meMedianState* state);
+	uint8_t getSortMedian(const cv::Mat& frame, const cv::Point& pt, const int& half, std::vector<uint8_t>* sortBuffer);
+	void makeGridRowPlan(const int& row, const int& frameCols, InBoxChecker* inBoxChecker, std::vector<std::pair<int, int>>* rowPlan);
+	int mapHueRowsSparse(const cv::Mat& BGRFrame, const int& frameTop, const int& gridRowBegin, const int& gridRowEnd,
+		InBoxChecker* inBoxChecker, const uint8_t* tablePtr, cv::Mat* hueMappedFrame,
+		std::vector<uchar>* columnMasks, std::vector<std::pair<int, int>>* rowPlan);
+	void makeFlagRows(const cv::Mat& hueDetectedFrame, const int& frameTop, const int& gridRowBegin, const int& gridRowEnd,
+		cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker, meMedianState* medianState);
+	int makeBoxFromFlagFrame(cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker,
+		const int& originalBoxRows, const int& originalBoxCols, const std::string& name);
+	void makeLabelSkipBits(const cv::Mat& boxFlagFrame, InBoxChecker* inBoxChecker);
+	void labelStripRuns(const cv::Mat& boxFlagFrame, meLabelStrip* strip);
+	int addBoxesFromLabelStrips(std::vector<meLabelStrip>* strips, const int& flagCols, InBoxChecker* inBoxChecker,
+		const int& originalBoxRows, const int& originalBoxCols, const std::string& name);
 
 	int mMedianBlurSize;
 	int mDownSamplingSize;
 	int mDownSamplingSize_Half;
 	std::vector<uint8_t> mMedianBlurTempVector;
+	eMedianEngine mMedianEngine = Median_Histogram;
+	eLabelingEngine mLabelingEngine = Labeling_FloodFill; // Union-find is opt-in, its boxes can differ
+	int mLabelingThreadCount = 0;        // 0 = hardware concurrency
+	std::vector<uint64_t> mLabelSkipBits; // Flag cells covered by boxes registered before labeling, one bit per cell
+	meMedianState mMedianState;
+
+	bool mbSparseEvaluation = false;  // Only used when PushThroughImage gets no HSV frame
+	int mLastTouchedPixelCount = 0;   // Pixels color-converted by the last PushThroughImage
+	std::vector<uchar> mSparseColumnMasks; // Per grid row, columns covered by the median windows
+	std::vector<cv::Mat> mAllRangesDetectedFrames;
+
+	int mBandThreadCount = 1;                     // 1 = single-threaded PushThroughImage
+	std::shared_ptr<ThreadPool> mBandPool;
+	std::shared_ptr<ThreadPool> mLabelingPool;    // Union-find strips when there is no band pool
+	std::vector<meMedianState> mBandMedianStates; // One per band
+	std::vector<cv::Mat> mBandHueFrames;          // Hue-mapped rows of each band, halo rows included
+	std::vector<std::vector<uchar>> mBandColumnMasks; // Sparse mode column masks of each band
+
+	bool mbTiledExecution = false;
+	int mTileCacheBytes = 256 * 1024;             // Working set budget of one tile (L2 size)
+	std::vector<std::vector<std::pair<int, int>>> mGridRowPlans; // makeGridRowPlan result of every grid row
+	std::vector<meMedianState> mTileMedianStates; // One per tile row
+	std::vector<cv::Mat> mTileHueFrames;          // Hue-mapped pixels of the current tile of each tile row
+
+	bool mbDebugDisplay = false;                  // Show and save the intermediate frames of PushThroughImage
 
 	std::vector<cv::Mat> mBackgroundSamples;
 	std::vector<cv::Mat> mColorSamples;
@@ -72,14 +165,34 @@ public:
 	void ClearColorDetectionRange();
 	void SetMedianBlurSize(const eMedianBlurSizes& medianBlurSize);
 	void SetDownSamplingSize(const eDownSamplingSizes& samplingSize);
+	void SetMedianEngine(const eMedianEngine& medianEngine);
+	void SetSparseEvaluation(const bool& isSparseEvaluation);
+	void SetLabelingEngine(const eLabelingEngine& labelingEngine, const int& threadCount = 0);
+	void SetBandThreadCount(const int& threadCount);
+	int GetBandThreadCount();
+	void SetTiledExecution(const bool& isTiledExecution, const int& tileCacheBytes = 256 * 1024);
+	void SetDebugDisplay(const bool& isDebugDisplay);
+	bool IsDebugDisplay();
+	int GetLastTouchedPixelCount();
 	int PushThroughImage(const cv::Mat& testFrame, cv::Mat* HSVedFrame,
 		InBoxChecker* inBoxChecker, const int& detectionIndex = 0);
+	int PushThroughImageAllRanges(const cv::Mat& testFrame, cv::Mat* HSVedFrame,
+		InBoxChecker* inBoxChecker, std::vector<ColorDetectionResult>* results);
+	void MapHueFrame(const cv::Mat& HSVFrame, cv::Mat* hueMappedFrame, const int& detectionIndex = 0, const bool& isDirectMappingKernel = false);
+	void MapHueFrameFromBGR(const cv::Mat& BGRFrame, cv::Mat* hueMappedFrame, cv::Mat* HSVFrame = nullptr, const int& detectionIndex = 0);
+	int MapHueFrameSparse(const cv::Mat& BGRFrame, cv::Mat* hueMappedFrame, InBoxChecker* inBoxChecker, const int& detectionIndex = 0);
 
 	int MakeBoxWithMedianBlur(cv::Mat* hueDetectedFrame, cv::Mat* boxFlagFrame,
 		InBoxChecker* inBoxChecker, const std::string& name);
+	int MakeBoxWithBands(const cv::Mat& BGRFrame, cv::Mat* hueMappedFrame, cv::Mat* boxFlagFrame,
+		InBoxChecker* inBoxChecker, const int& detectionIndex = 0);
+	int MakeBoxWithTiles(const cv::Mat& BGRFrame, cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker, const int& detectionIndex = 0);
 	uint8_t DoMedianBlur(cv::Mat* frame, const cv::Point& pt, const int& medianBlurHalfSize);
+	void DoGridMedianBlur(const cv::Mat& frame, cv::Mat* gridFrame, const eMedianEngine& medianEngine);
 	int MakeBoxWithFloodFill(cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker,
 		const int& originalBoxRows, const int& originalBoxCols, const std::string& name);
+	int MakeBoxWithUnionFind(cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker,
+		const int& originalBoxRows, const int& originalBoxCols, const std::string& name, const int& threadCount = 1);
 
 	void MakeColorDetection(const std::string& colorSampleFolder, const int& hueMargin = 8);
 };
@@ -133,10 +246,30 @@ void ColorDetection::AddColorDetectionRange(const int& positivePointZero, const
 
 	newRange.mName = name;
 
+	makeHueSatTable(&newRange);
 
 	mHueDetectionRanges.push_back(newRange);
 }
 
+//  (hue, saturation) ѽֿ ޷Ƿ 256x256 츦 ̸  صд.
+//colorHueMapping ״ ҷ Ƿ ȼ   Ȱ.
+void ColorDetection::makeHueSatTable(meHueDetectionRange* currHueDetectionRange)
+{
+	auto& currHueDetectionRange_ = *currHueDetectionRange;
+
+	currHueDetectionRange_.mHueSatTable.resize(256 * 256);
+	uint8_t* tablePtr = currHueDetectionRange_.mHueSatTable.data();
+
+	for (int h = 0; h < 256; h++)
+	{
+		for (int s = 0; s < 256; s++)
+		{
+			//127 ϴ   պƮ Flag  ؼ̴.
+			tablePtr[(h << 8) | s] = (uchar)(int)(colorHueMapping((float)h, s, &currHueDetectionRange_) * 127);
+		}
+	}
+}
+
 //÷ ؼ  ̿ؼ HUE ϴ Լ
 float ColorDetection::colorHueMapping(float mappingValue, const int& curSaturation, meHueDetectionRange* curHueDetectionRange)
 {
@@ -191,281 +324,1475 @@ void ColorDetection::SetDownSamplingSize(const eDownSamplingSizes& samplingSize)
 int ColorDetection::PushThroughImage(const cv::Mat& testFrame, cv::Mat* HSVedFrame, 
 	InBoxChecker* inBoxChecker, const int& detectionIndex)
 {
-	auto& HSVedFrame_ = *HSVedFrame;
 	auto& inBoxChecker_ = *inBoxChecker;
 
-	cv::Mat HSV_Frame = cv::Mat(testFrame.rows, testFrame.cols, CV_8UC3);
-	cv::Mat detectedFrame = cv::Mat::zeros(testFrame.rows, testFrame.cols, CV_8UC1);
-	//cv::Mat medianBluredFrame;
-	cv::cvtColor(testFrame, HSV_Frame, cv::COLOR_BGR2HSV);
-	cv::Vec3b* HSVframePtr;
-	uchar* detectedFramePtr = detectedFrame.ptr(0);
-
-	float hueVal;
-	//int jumping_width;
-
+	cv::Mat detectedFrame;
 	int flagRow = (testFrame.rows - mDownSamplingSize_Half - 1) / mDownSamplingSize + 1;
 	int flagCol = (testFrame.cols - mDownSamplingSize_Half - 1) / mDownSamplingSize + 1;
 	cv::Mat BoxFlagFrame = cv::Mat::zeros(flagRow + 2, flagCol + 2, CV_8UC1);
 
-	//Hue÷   
-	for (int r = 0; r < HSV_Frame.rows; r++)
+	int detectedPixelCount = 0;
+
+	//Ÿ  Ÿϸ ȯ ׸ ޵ ̾ ϰ ÷ ʸ (hue  ü  ).
+	// 尡  ȯ, ޵, 󺧸 帶  Ѵ.   󺧸    ο ȴ.
+	//  HSV  ޶ ϸ   η .  δ  ǥø  ü hue  
+	if (mbTiledExecution && (HSVedFrame == nullptr))
+	{
+		detectedPixelCount = MakeBoxWithTiles(testFrame, &BoxFlagFrame, &inBoxChecker_, detectionIndex);
+	}
+	else if ((mBandThreadCount > 1) && (HSVedFrame == nullptr))
+	{
+		detectedPixelCount = MakeBoxWithBands(testFrame, mbDebugDisplay ? &detectedFrame : nullptr, &BoxFlagFrame, &inBoxChecker_, detectionIndex);
+	}
+	else
 	{
-		HSVframePtr = HSV_Frame.ptr<cv::Vec3b>(r);
-		detectedFramePtr = detectedFrame.ptr(r);
-		for (int c = 0; c < HSV_Frame.cols; c++)
+		//Hue÷   . HSV  HSVedFrame ޶   .
+		//  ׸ ޵ д 츸 ȯϴµ, HSV  ü ޶ ϸ ü ȯ Ѵ
+		if (mbSparseEvaluation && (HSVedFrame == nullptr))
 		{
-
-			hueVal = colorHueMapping(HSVframePtr[c][0], HSVframePtr[c][1], &mHueDetectionRanges[detectionIndex]);
-			//127 ϴ   պƮ Flag  ؼ̴.
-			detectedFramePtr[c] = (int)(hueVal * 127);
+			mLastTouchedPixelCount = MapHueFrameSparse(testFrame, &detectedFrame, &inBoxChecker_, detectionIndex);
+		}
+		else
+		{
+			MapHueFrameFromBGR(testFrame, &detectedFrame, HSVedFrame, detectionIndex);
+			mLastTouchedPixelCount = testFrame.rows * testFrame.cols;
 		}
-	}
-
 
-	//޵   ٿø  ̾Ƴ  Ѵ.
-	//ȯ ÷׸ʿ   ÷ ȼ *ٿø ũ^2  ȴ.
-	int detectedPixelCount = MakeBoxWithMedianBlur(&detectedFrame, &BoxFlagFrame, &inBoxChecker_ ,mHueDetectionRanges[detectionIndex].mName);
-	cv::Mat testTempFrame;
-	cv::resize(BoxFlagFrame, testTempFrame, cv::Size(detectedFrame.cols, detectedFrame.rows), 0, 0, cv::InterpolationFlags::INTER_LINEAR);
-	cv::imshow("sampling", testTempFrame);
-	cv::imwrite("./imwrite_imgs/sampling.jpg", testTempFrame);
+		//޵   ٿø  ̾Ƴ  Ѵ.
+		//ȯ ÷׸ʿ   ÷ ȼ *ٿø ũ^2  ȴ.
+		detectedPixelCount = MakeBoxWithMedianBlur(&detectedFrame, &BoxFlagFrame, &inBoxChecker_, mHueDetectionRanges[detectionIndex].mName);
+	}
+	//߰  â ̹   忡  ü ٽ а ڵϹǷ  ǥø  Ѵ
+	if (mbDebugDisplay)
+	{
+		cv::Mat testTempFrame;
+		cv::resize(BoxFlagFrame, testTempFrame, cv::Size(testFrame.cols, testFrame.rows), 0, 0, cv::InterpolationFlags::INTER_LINEAR);
+		cv::imshow("sampling", testTempFrame);
+		cv::imwrite("./imwrite_imgs/sampling.jpg", testTempFrame);
 
-	cv::imshow("HSV_Hue mapped frame", detectedFrame);
-	cv::imwrite("./imwrite_imgs/HSV_Hue mapped frame.jpg", detectedFrame);
+		//Ÿ 忡 hue  
+		if (detectedFrame.empty() == false)
+		{
+			cv::imshow("HSV_Hue mapped frame", detectedFrame);
+			cv::imwrite("./imwrite_imgs/HSV_Hue mapped frame.jpg", detectedFrame);
 
-	cv::Mat medianBluredFrame;
-	cv::medianBlur(detectedFrame, medianBluredFrame, mMedianBlurSize);
-	cv::imshow("sampling_medianBlured", medianBluredFrame);
-	cv::imwrite("./imwrite_imgs/sampling_medianBlured.jpg", medianBluredFrame);
+			cv::Mat medianBluredFrame;
+			cv::medianBlur(detectedFrame, medianBluredFrame, mMedianBlurSize);
+			cv::imshow("sampling_medianBlured", medianBluredFrame);
+			cv::imwrite("./imwrite_imgs/sampling_medianBlured.jpg", medianBluredFrame);
+		}
+	}
 
 
-	HSV_Frame.copyTo(HSVedFrame_);
 	return detectedPixelCount;
 };
 
-//޵  ؼ ڽ . δ FloodFill ˰ Ǿ.
-int ColorDetection::MakeBoxWithMedianBlur(cv::Mat* hueDetectedFrame, cv::Mat* boxFlagFrame, 
-	InBoxChecker* inBoxChecker,const std::string& name)
+//HSV  hue  (0~127)  ٲ۴. ⺻ ̸  (hue, saturation) ̺  ´.
+//isDirectMappingKernel̸ ó ȼ colorHueMapping Ѵ. ġũ, 񱳿
+void ColorDetection::MapHueFrame(const cv::Mat& HSVFrame, cv::Mat* hueMappedFrame, const int& detectionIndex, const bool& isDirectMappingKernel)
 {
-	auto& hueDetectedFrame_ = *hueDetectedFrame;
-	auto& boxFlagFrame_ = *boxFlagFrame;
-	auto& inBoxChecker_ = *inBoxChecker;
+	auto& hueMappedFrame_ = *hueMappedFrame;
 
+	hueMappedFrame_.create(HSVFrame.rows, HSVFrame.cols, CV_8UC1);
 
-	int jumpingWidth = 0;
-	int medianBlurHalf = mMedianBlurSize / 2;
-
-	uchar* boxFlagFramePtr;
+	const cv::Vec3b* HSVframePtr;
 	uchar* detectedFramePtr;
 
-	int flagRow = 1;
-	int flagCol = 1;
-
-	for (int r = mDownSamplingSize_Half; r < hueDetectedFrame_.rows; r += mDownSamplingSize)
+	if (isDirectMappingKernel)
 	{
-		detectedFramePtr = hueDetectedFrame_.ptr(r);
-		boxFlagFramePtr = boxFlagFrame_.ptr(flagRow);
-
-		flagCol = 1;
-		for (int c = mDownSamplingSize_Half; c < hueDetectedFrame_.cols; c += mDownSamplingSize)
+		float hueVal;
+		for (int r = 0; r < HSVFrame.rows; r++)
 		{
-			if (inBoxChecker_.CheckInBox(cv::Point(c, r), &jumpingWidth))
+			HSVframePtr = HSVFrame.ptr<cv::Vec3b>(r);
+			detectedFramePtr = hueMappedFrame_.ptr(r);
+			for (int c = 0; c < HSVFrame.cols; c++)
 			{
-				c = c + ((((jumpingWidth) / mDownSamplingSize) + 1) * mDownSamplingSize);
-				flagCol = ((c - 4) / mDownSamplingSize) + 1;
-				flagCol++;
-				continue;
+				hueVal = colorHueMapping(HSVframePtr[c][0], HSVframePtr[c][1], &mHueDetectionRanges[detectionIndex]);
+				//127 ϴ   պƮ Flag  ؼ̴.
+				detectedFramePtr[c] = (int)(hueVal * 127);
 			}
-			boxFlagFramePtr[flagCol] = DoMedianBlur(&hueDetectedFrame_, cv::Point(c, r), medianBlurHalf);
-			auto asdf = boxFlagFramePtr[flagCol];
+		}
+		return;
+	}
 
-			flagCol++;
+	const uint8_t* tablePtr = mHueDetectionRanges[detectionIndex].mHueSatTable.data();
+	for (int r = 0; r < HSVFrame.rows; r++)
+	{
+		HSVframePtr = HSVFrame.ptr<cv::Vec3b>(r);
+		detectedFramePtr = hueMappedFrame_.ptr(r);
+		for (int c = 0; c < HSVFrame.cols; c++)
+		{
+			detectedFramePtr[c] = tablePtr[(HSVframePtr[c][0] << 8) | HSVframePtr[c][1]];
 		}
-		flagRow++;
 	}
+}
 
-	int totalDetectedPixelCount = MakeBoxWithFloodFill(&boxFlagFrame_, &inBoxChecker_, hueDetectedFrame_.rows, hueDetectedFrame_.cols,name);
+//cv::cvtColor(COLOR_BGR2HSV) 8Ʈ     ̺. 12Ʈ Ҽ
+static const int HSV_SHIFT = 12;
+struct HSVDivTables
+{
+	int SDiv[256];
+	int HDiv[256];
 
-	return totalDetectedPixelCount;
+	HSVDivTables()
+	{
+		SDiv[0] = 0;
+		HDiv[0] = 0;
+		for (int i = 1; i < 256; i++)
+		{
+			SDiv[i] = cv::saturate_cast<int>((255 << HSV_SHIFT) / (1.0 * i));
+			HDiv[i] = cv::saturate_cast<int>((180 << HSV_SHIFT) / (6.0 * i));
+		}
+	}
 };
 
-//ѹ    ڽ÷׸Ʈ ̿ؼ ڽ  ιڽüĿ ϴ Լ
-//ȯ   ȼ ̴.
-int ColorDetection::MakeBoxWithFloodFill(cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker, 
-	const int& originalBoxRows, const int& originalBoxCols, const std::string& name)
+static const HSVDivTables& getHSVDivTables()
 {
-	auto& boxFlagFrame_ = *boxFlagFrame;
-	auto& inBoxChecker_ = *inBoxChecker;
-
-	uchar* boxFlagFramePtr;
-
-	std::queue<cv::Point> pointQue;
-	uchar val;
-	int addWidth;
-
-	cv::Point curPt;
-
-	cv::Point pt_Up;
-	cv::Point pt_Down;
-	cv::Point pt_Left;
-	cv::Point pt_Right;
+	static HSVDivTables tables;
+	return tables;
+}
 
-	cv::Point pt_UpLeft;
-	cv::Point pt_DownRight;
+//max, diff hue ڰ hue(0~179), saturation Ѵ. cvtColor  ݿø
+static inline void finishHueSat(const int& v, const int& diff, const int& hueNumerator, const HSVDivTables& tables, int* h, int* s)
+{
+	*s = (diff * tables.SDiv[v] + (1 << (HSV_SHIFT - 1))) >> HSV_SHIFT;
+	*h = (hueNumerator * tables.HDiv[diff] + (1 << (HSV_SHIFT - 1))) >> HSV_SHIFT;
+	if (*h < 0) *h += 180;
+}
 
-	int totalDetectedPixel = 0;
+//ȼ ϳ hue ڰ. max r̸ g-b, g̸ b-r+2diff, ƴϸ r-g+4diff
+static inline int getHueNumerator(const int& b, const int& g, const int& r, const int& v, const int& diff)
+{
+	if (v == r) return g - b;
+	if (v == g) return b - r + 2 * diff;
+	return r - g + 4 * diff;
+}
 
-	for (int r = 1; r < boxFlagFrame_.rows - 1; r++)
+//BGR   [offset, offset + count)  о  hue   .
+//max/min, hue ڰ 16ȼ SIMD ϰ,  ̺  ̺ ȸ ȼ Ѵ.
+static void mapHueRowFromBGR(const uchar* BGRFramePtr, const int& offset, const int& count, const int& rangeCount,
+	const uint8_t* const* tablePtrs, uchar* const* detectedFramePtrs, uchar* HSVFramePtr)
+{
+	const HSVDivTables& tables = getHSVDivTables();
+
+	int h, s, hueSatIndex;
+	int c = offset;
+	int end = offset + count;
+#if CV_SIMD128
+	uchar maxValues[16];
+	uchar diffValues[16];
+	short hueNumerators[16];
+	for (; c <= end - 16; c += 16)
 	{
-		boxFlagFramePtr = boxFlagFrame_.ptr(r);
-		for (int c = 1; c < boxFlagFrame_.cols - 1; c++)
+		cv::v_uint8x16 blue, green, red;
+		cv::v_load_deinterleave(BGRFramePtr + c * 3, blue, green, red);
+
+		cv::v_uint8x16 maxValue = cv::v_max(cv::v_max(blue, green), red);
+		cv::v_uint8x16 diff = maxValue - cv::v_min(cv::v_min(blue, green), red);
+		cv::v_store(maxValues, maxValue);
+		cv::v_store(diffValues, diff);
+
+		//16Ʈ ÷ hue ڰ Ѵ.  -255~1020
+		cv::v_uint16x8 b16[2], g16[2], r16[2], v16[2], d16[2];
+		cv::v_expand(blue, b16[0], b16[1]);
+		cv::v_expand(green, g16[0], g16[1]);
+		cv::v_expand(red, r16[0], r16[1]);
+		cv::v_expand(maxValue, v16[0], v16[1]);
+		cv::v_expand(diff, d16[0], d16[1]);
+
+		for (int half = 0; half < 2; half++)
 		{
-			//̹ ִ ڽ Եȴٸ  ѱ
-			if (inBoxChecker_.CheckInBox(cv::Point((c - 1) * mDownSamplingSize + mDownSamplingSize_Half,
-				(r - 1) * mDownSamplingSize + mDownSamplingSize_Half), &addWidth))
+			cv::v_int16x8 bs = cv::v_reinterpret_as_s16(b16[half]);
+			cv::v_int16x8 gs = cv::v_reinterpret_as_s16(g16[half]);
+			cv::v_int16x8 rs = cv::v_reinterpret_as_s16(r16[half]);
+			cv::v_int16x8 vs = cv::v_reinterpret_as_s16(v16[half]);
+			cv::v_int16x8 ds = cv::v_reinterpret_as_s16(d16[half]);
+
+			cv::v_int16x8 hueRed = gs - bs;
+			cv::v_int16x8 hueGreen = bs - rs + ds + ds;
+			cv::v_int16x8 hueBlue = rs - gs + ds + ds + ds + ds;
+			cv::v_int16x8 hueNumerator = cv::v_select(vs == rs, hueRed, cv::v_select(vs == gs, hueGreen, hueBlue));
+			cv::v_store(hueNumerators + half * 8, hueNumerator);
+		}
+
+		for (int i = 0; i < 16; i++)
+		{
+			finishHueSat(maxValues[i], diffValues[i], hueNumerators[i], tables, &h, &s);
+			hueSatIndex = (h << 8) | s;
+			for (int k = 0; k < rangeCount; k++)
 			{
-				c = c + ((addWidth / mDownSamplingSize) + 1);
-				continue;
+				detectedFramePtrs[k][c + i] = tablePtrs[k][hueSatIndex];
+			}
+			if (HSVFramePtr != nullptr)
+			{
+				HSVFramePtr[(c + i) * 3] = (uchar)h;
+				HSVFramePtr[(c + i) * 3 + 1] = (uchar)s;
+				HSVFramePtr[(c + i) * 3 + 2] = maxValues[i];
 			}
+		}
+	}
+#endif
+	for (; c < end; c++)
+	{
+		int b = BGRFramePtr[c * 3];
+		int g = BGRFramePtr[c * 3 + 1];
+		int r = BGRFramePtr[c * 3 + 2];
+		int v = std::max(std::max(b, g), r);
+		int diff = v - std::min(std::min(b, g), r);
+
+		finishHueSat(v, diff, getHueNumerator(b, g, r, v, diff), tables, &h, &s);
+		hueSatIndex = (h << 8) | s;
+		for (int k = 0; k < rangeCount; k++)
+		{
+			detectedFramePtrs[k][c] = tablePtrs[k][hueSatIndex];
+		}
+		if (HSVFramePtr != nullptr)
+		{
+			HSVFramePtr[c * 3] = (uchar)h;
+			HSVFramePtr[c * 3 + 1] = (uchar)s;
+			HSVFramePtr[c * 3 + 2] = (uchar)v;
+		}
+	}
+}
 
-			val = boxFlagFramePtr[c];
+//BGR  ٷ hue    ٲ۴. HSV    ٽ  ʴ´.
+// cvtColor(COLOR_BGR2HSV)  MapHueFrame Ͱ . HSVFrame nullptr ƴϸ HSV  ش
+void ColorDetection::MapHueFrameFromBGR(const cv::Mat& BGRFrame, cv::Mat* hueMappedFrame, cv::Mat* HSVFrame, const int& detectionIndex)
+{
+	// ũ create ۸ ״ Ƿ hueMappedFrame ٷ 
+	std::vector<cv::Mat> hueMappedFrames(1, *hueMappedFrame);
+	mapHueFramesFromBGR(BGRFrame, std::vector<int>(1, detectionIndex), &hueMappedFrames, HSVFrame);
+	*hueMappedFrame = hueMappedFrames[0];
+}
 
-			//floodfill 
-			if (val > 0)
-			{
-				// Ⱥ ִٸ      ̹Ƿ..  Ӱ ʱȭ ʿ ڴ.
-				pointQue.push(cv::Point(c, r));
+//BGR ѹ 鼭 detectionIndices  hue    .
+void ColorDetection::mapHueFramesFromBGR(const cv::Mat& BGRFrame, const std::vector<int>& detectionIndices,
+	std::vector<cv::Mat>* hueMappedFrames, cv::Mat* HSVFrame)
+{
+	auto& hueMappedFrames_ = *hueMappedFrames;
 
-				pt_UpLeft = cv::Point(c, r);
-				pt_DownRight = cv::Point(c, r);
+	int rangeCount = (int)detectionIndices.size();
+	hueMappedFrames_.resize(rangeCount);
 
-				boxFlagFrame_.at<uchar>(cv::Point(c, r)) += 0x80;
+	std::vector<const uint8_t*> tablePtrs(rangeCount);
+	std::vector<uchar*> detectedFramePtrs(rangeCount);
+	for (int k = 0; k < rangeCount; k++)
+	{
+		hueMappedFrames_[k].create(BGRFrame.rows, BGRFrame.cols, CV_8UC1);
+		tablePtrs[k] = mHueDetectionRanges[detectionIndices[k]].mHueSatTable.data();
+	}
+	if (HSVFrame != nullptr)
+	{
+		HSVFrame->create(BGRFrame.rows, BGRFrame.cols, CV_8UC3);
+	}
 
-				while (pointQue.empty() == false)
-				{
-					//ϴ ȼ Ǿ ϳ ߰ϰ 
-					totalDetectedPixel++;
+	for (int r = 0; r < BGRFrame.rows; r++)
+	{
+		for (int k = 0; k < rangeCount; k++)
+		{
+			detectedFramePtrs[k] = hueMappedFrames_[k].ptr(r);
+		}
+		uchar* HSVFramePtr = (HSVFrame != nullptr) ? HSVFrame->ptr<uchar>(r) : nullptr;
 
-					curPt = pointQue.front();
-					pointQue.pop();
+		mapHueRowFromBGR(BGRFrame.ptr<uchar>(r), 0, BGRFrame.cols, rangeCount, tablePtrs.data(), detectedFramePtrs.data(), HSVFramePtr);
+	}
+}
 
-					pt_Up = curPt;
-					pt_Up.y -= 1;
+//ٿø ׸忡  ޵    ȼ hue Ѵ.  ȼ 0 д.
+//ιڽüĿ ڽ  ׸  MakeBoxWithMedianBlur   ǳʶٹǷ   ȯ ʴ´.
+//ȯ ȯ ȼ 
+int ColorDetection::MapHueFrameSparse(const cv::Mat& BGRFrame, cv::Mat* hueMappedFrame, InBoxChecker* inBoxChecker, const int& detectionIndex)
+{
+	auto& hueMappedFrame_ = *hueMappedFrame;
 
-					pt_Down = curPt;
-					pt_Down.y += 1;
+	hueMappedFrame_ = cv::Mat::zeros(BGRFrame.rows, BGRFrame.cols, CV_8UC1);
 
-					pt_Left = curPt;
-					pt_Left.x -= 1;
+	int gridRows = (BGRFrame.rows - mDownSamplingSize_Half - 1) / mDownSamplingSize + 1;
+	const uint8_t* tablePtr = mHueDetectionRanges[detectionIndex].mHueSatTable.data();
 
-					pt_Right = curPt;
-					pt_Right.x += 1;
+	return mapHueRowsSparse(BGRFrame, 0, 0, gridRows, inBoxChecker, tablePtr, &hueMappedFrame_, &mSparseColumnMasks, &mMedianState.RowPlan);
+}
 
-					// ˻,  Ʈ 128 ǹϴ Ʈ ϴ ˻Ѵ. ̰ ü flag Ѵ.
-					if (boxFlagFrame_.at<uchar>(pt_Right) > 0)
-					{
-						if ((boxFlagFrame_.at<uchar>(pt_Right) >> 7) == 0x00)
-						{
-							//˻簡 ȵǾ־ٸ, ť Ӱ ְ,
-							pointQue.push(pt_Right);
-							if (pt_Right.x > pt_DownRight.x) pt_DownRight.x = pt_Right.x;
-							boxFlagFrame_.at<uchar>(pt_Right) += 0x80;
-						}
-					}
-					//Ʒ ˻
-					if (boxFlagFrame_.at<uchar>(pt_Down) > 0)
-					{
-						if ((boxFlagFrame_.at<uchar>(pt_Down) >> 7) == 0x00)
-						{
-							pointQue.push(pt_Down);
-							if (pt_Down.y > pt_DownRight.y) pt_DownRight.y = pt_Down.y;
-							boxFlagFrame_.at<uchar>(pt_Down) += 0x80;
-						}
-					}
-					// ˻
-					if (boxFlagFrame_.at<uchar>(pt_Left) > 0)
-					{
-						if ((boxFlagFrame_.at<uchar>(pt_Left) >> 7) == 0x00)
-						{
-							pointQue.push(pt_Left);
-							if (pt_Left.x < pt_UpLeft.x) pt_UpLeft.x = pt_Left.x;
-							boxFlagFrame_.at<uchar>(pt_Left) += 0x80;
-						}
-					}
-					// ˻
-					if (boxFlagFrame_.at<uchar>(pt_Up) > 0)
-					{
-						if ((boxFlagFrame_.at<uchar>(pt_Up) >> 7) == 0x00)
-						{
-							pointQue.push(pt_Up);
-							if (pt_Up.y < pt_UpLeft.y) pt_UpLeft.y = pt_Up.y;
-							boxFlagFrame_.at<uchar>(pt_Up) += 0x80;
-						}
-					}
-				}
+//׸  [gridRowBegin, gridRowEnd) ޵ 찡  ȼ ߿  frameTop  hueMappedFrame  ŭ hue Ѵ.
+//hueMappedFrame ̸ 0 ä ѱ.  δ 帶 ڱ ׸  ҷ ุ ѱ. ȯ ȯ ȼ 
+int ColorDetection::mapHueRowsSparse(const cv::Mat& BGRFrame, const int& frameTop, const int& gridRowBegin, const int& gridRowEnd,
+	InBoxChecker* inBoxChecker, const uint8_t* tablePtr, cv::Mat* hueMappedFrame,
+	std::vector<uchar>* columnMasks, std::vector<std::pair<int, int>>* rowPlan)
+{
+	auto& hueMappedFrame_ = *hueMappedFrame;
+	auto& columnMasks_ = *columnMasks;
+	auto& rowPlan_ = *rowPlan;
 
-				//ڽ  ũ+ѿ ĭ  鸮
-				pt_UpLeft = (pt_UpLeft - cv::Point(2, 2)) * mDownSamplingSize + cv::Point(mDownSamplingSize_Half, mDownSamplingSize_Half);
-				pt_DownRight = (pt_DownRight * mDownSamplingSize + cv::Point(mDownSamplingSize_Half, mDownSamplingSize_Half));
+	int medianBlurHalf = mMedianBlurSize / 2;
 
-				//    ʾҴ ˻
-				if (pt_UpLeft.x < 0) pt_UpLeft.x = 0;
-				if (pt_UpLeft.y < 0) pt_UpLeft.y = 0;
-				if (pt_DownRight.x > originalBoxCols - 1) pt_DownRight.x = originalBoxCols - 1;
-				if (pt_DownRight.y > originalBoxRows - 1) pt_DownRight.y = originalBoxRows - 1;
+	//׸ ึ 찡   ǥ. ޵   ÷  äﶧ  ȹ Ѵ
+	columnMasks_.assign((size_t)(gridRowEnd - gridRowBegin) * BGRFrame.cols, 0);
+	for (int gr = gridRowBegin; gr < gridRowEnd; gr++)
+	{
+		uchar* columnMaskPtr = columnMasks_.data() + (size_t)(gr - gridRowBegin) * BGRFrame.cols;
+		makeGridRowPlan(mDownSamplingSize_Half + gr * mDownSamplingSize, BGRFrame.cols, inBoxChecker, &rowPlan_);
+		for (size_t k = 0; k < rowPlan_.size(); k++)
+		{
+			int c = rowPlan_[k].first;
+			int left = std::max(0, c - medianBlurHalf);
+			int right = std::min(BGRFrame.cols, c + medianBlurHalf + 1);
+			std::fill(columnMaskPtr + left, columnMaskPtr + right, (uchar)1);
+		}
+	}
 
+	std::vector<uchar> rowMask(BGRFrame.cols);
+	int touchedPixelCount = 0;
 
+	for (int r = frameTop; r < frameTop + hueMappedFrame_.rows; r++)
+	{
+		//   ׸   ǥø ģ
+		int firstGridRow = std::max(gridRowBegin, (r - medianBlurHalf - mDownSamplingSize_Half + mDownSamplingSize - 1) / mDownSamplingSize);
+		int lastGridRow = std::min(gridRowEnd - 1, (r + medianBlurHalf - mDownSamplingSize_Half) / mDownSamplingSize);
+		if ((r + medianBlurHalf < mDownSamplingSize_Half) || (firstGridRow > lastGridRow))
+		{
+			continue;
+		}
 
-				cv::Rect newRect = cv::Rect(pt_UpLeft, pt_DownRight);
-				inBoxChecker_.AddBox(newRect, InBoxChecker::ColorDetection, name);
+		std::fill(rowMask.begin(), rowMask.end(), (uchar)0);
+		for (int gr = firstGridRow; gr <= lastGridRow; gr++)
+		{
+			const uchar* columnMaskPtr = columnMasks_.data() + (size_t)(gr - gridRowBegin) * BGRFrame.cols;
+			for (int c = 0; c < BGRFrame.cols; c++)
+			{
+				rowMask[c] |= columnMaskPtr[c];
+			}
+		}
 
+		const uchar* BGRFramePtr = BGRFrame.ptr<uchar>(r);
+		uchar* detectedFramePtr = hueMappedFrame_.ptr(r - frameTop);
 
+		//ǥõ   ȯ
+		int c = 0;
+		while (c < BGRFrame.cols)
+		{
+			if (rowMask[c] == 0)
+			{
+				c++;
+				continue;
 			}
+			int runStart = c;
+			while ((c < BGRFrame.cols) && (rowMask[c] != 0)) c++;
 
+			mapHueRowFromBGR(BGRFramePtr, runStart, c - runStart, 1, &tablePtr, &detectedFramePtr, nullptr);
+			touchedPixelCount += c - runStart;
 		}
 	}
 
-	//ѹ  ȼ      .
-	// ÷׸ ٿø  ̿Ͽ, ÷׸ 1ĭ ٿø^2 ȼ Ѱ Ѵ.
-	//ӵ ,  Ȯ پ Ʈ̵  .
-	totalDetectedPixel = totalDetectedPixel * mDownSamplingSize * mDownSamplingSize;
-
-	return totalDetectedPixel;
-};
+	return touchedPixelCount;
+}
 
-//Ư  ޵  ϴ Լ. ̳ʽ ǥ ؼ ̾.
-uint8_t ColorDetection::DoMedianBlur(cv::Mat* frame, const cv::Point& pt, const int& medianBlurHalfSize)
+//ϵ  ÷   ѹ о óѴ.     
+//׸ ޵Ȱ ÷    ڽ ȼ  results ´.
+//ڽ ιڽüĿ ϵǸ,   PushThroughImage θ Ͱ    ڽ  ǳʶڴ.
+//ȯ    ȼ  
+int ColorDetection::PushThroughImageAllRanges(const cv::Mat& testFrame, cv::Mat* HSVedFrame,
+	InBoxChecker* inBoxChecker, std::vector<ColorDetectionResult>* results)
 {
-	auto& frame_ = *frame;
+	auto& inBoxChecker_ = *inBoxChecker;
+	auto& results_ = *results;
+
+	int rangeCount = (int)mHueDetectionRanges.size();
+	std::vector<int> detectionIndices(rangeCount);
+	for (int k = 0; k < rangeCount; k++)
+	{
+		detectionIndices[k] = k;
+	}
+
+	mapHueFramesFromBGR(testFrame, detectionIndices, &mAllRangesDetectedFrames, HSVedFrame);
 
-	uchar* framePtr;;// = frame.ptr<uchar>(0);
-	uint8_t i = 0;
-	uint8_t correct = 0;
+	int flagRow = (testFrame.rows - mDownSamplingSize_Half - 1) / mDownSamplingSize + 1;
+	int flagCol = (testFrame.cols - mDownSamplingSize_Half - 1) / mDownSamplingSize + 1;
 
-	for (int r = pt.y - medianBlurHalfSize; r <= pt.y + medianBlurHalfSize; r++)
+	results_.resize(rangeCount);
+	int totalDetectedPixelCount = 0;
+	for (int k = 0; k < rangeCount; k++)
 	{
+		auto& result = results_[k];
+		result.Name = mHueDetectionRanges[k].mName;
+		result.Boxes.clear();
 
-		for (int c = pt.x - medianBlurHalfSize; c <= pt.x + medianBlurHalfSize; c++)
+		cv::Mat boxFlagFrame = cv::Mat::zeros(flagRow + 2, flagCol + 2, CV_8UC1);
+
+		int boxCountBefore = inBoxChecker_.GetBoxCount();
+		result.DetectedPixelCount = MakeBoxWithMedianBlur(&mAllRangesDetectedFrames[k], &boxFlagFrame, &inBoxChecker_, result.Name);
+		for (int b = boxCountBefore; b < inBoxChecker_.GetBoxCount(); b++)
 		{
-			if ((r >= frame_.rows) || (c >= frame_.cols) || (r < 0) || (c < 0))
-			{
-				mMedianBlurTempVector[i] = 0xFF;
-				i++;
-				continue;
-			}
-			framePtr = frame_.ptr<uchar>(r);
-			mMedianBlurTempVector[i] = framePtr[c];
-			i++;
-			correct++;
+			result.Boxes.push_back(inBoxChecker_.GetBox(b).Box);
 		}
+
+		totalDetectedPixelCount += result.DetectedPixelCount;
 	}
 
-	std::sort(mMedianBlurTempVector.begin(), mMedianBlurTempVector.end());
+	return totalDetectedPixelCount;
+}
 
-	return mMedianBlurTempVector[(correct + 1) / 2 - 1];
+//׷ ޵   (8Ʈ )
+static const int MEDIAN_BINS = 256;
 
-};
+static inline void addHistogram(uint16_t* dst, const uint16_t* src)
+{
+#if CV_SIMD128
+	for (int i = 0; i < MEDIAN_BINS; i += 8)
+	{
+		cv::v_store(dst + i, cv::v_load(dst + i) + cv::v_load(src + i));
+	}
+#else
+	for (int i = 0; i < MEDIAN_BINS; i++) dst[i] += src[i];
+#endif
+}
+
+static inline void subHistogram(uint16_t* dst, const uint16_t* src)
+{
+#if CV_SIMD128
+	for (int i = 0; i < MEDIAN_BINS; i += 8)
+	{
+		cv::v_store(dst + i, cv::v_load(dst + i) - cv::v_load(src + i));
+	}
+#else
+	for (int i = 0; i < MEDIAN_BINS; i++) dst[i] -= src[i];
+#endif
+}
+
+//  ׸ ޵ Ҷ  ׷ 
+void ColorDetection::resetMedianHistograms(const cv::Mat& frame, meMedianState* state)
+{
+	auto& state_ = *state;
+
+	state_.ColumnHistograms.assign((size_t)frame.cols * MEDIAN_BINS, 0);
+	state_.KernelHistogram.assign(MEDIAN_BINS, 0);
+	state_.HistogramTop = state_.HistogramBottom = 0;
+	state_.KernelLeft = state_.KernelRight = 0;
+}
+
+// [centerRow - half, centerRow + half]  ׷  ְ Ѵ(Perreault ).
+// ׸  ġ  ״ ΰ  ุ   ุ ϹǷ,   ٿø ݿ Ѵ
+void ColorDetection::beginMedianRow(const cv::Mat& frame, const int& centerRow, const int& half, meMedianState* state)
+{
+	auto& state_ = *state;
+
+	int newTop = std::max(0, centerRow - half);
+	int newBottom = std::min(frame.rows, centerRow + half + 1);
+	uint16_t* columnHistPtr = state_.ColumnHistograms.data();
+
+	for (int r = state_.HistogramTop; r < state_.HistogramBottom; r++)
+	{
+		if ((r >= newTop) && (r < newBottom)) continue;
+		const uchar* framePtr = frame.ptr<uchar>(r);
+		for (int c = 0; c < frame.cols; c++)
+		{
+			columnHistPtr[c * MEDIAN_BINS + framePtr[c]]--;
+		}
+	}
+	for (int r = newTop; r < newBottom; r++)
+	{
+		if ((r >= state_.HistogramTop) && (r < state_.HistogramBottom)) continue;
+		const uchar* framePtr = frame.ptr<uchar>(r);
+		for (int c = 0; c < frame.cols; c++)
+		{
+			columnHistPtr[c * MEDIAN_BINS + framePtr[c]]++;
+		}
+	}
+
+	state_.HistogramTop = newTop;
+	state_.HistogramBottom = newBottom;
+
+	//Ŀ ׷ ึ  
+	std::fill(state_.KernelHistogram.begin(), state_.KernelHistogram.end(), (uint16_t)0);
+	state_.KernelLeft = state_.KernelRight = 0;
+}
+
+//beginMedianRow  ࿡ centerCol ߽  ޵. Ŀ ׷   ϰ   .
+//DoMedianBlur    0xFF ä  Ƿ,   ȼ correct  (correct + 1) / 2°  ̴
+uint8_t ColorDetection::getHistogramMedian(const cv::Mat& frame, const int& centerCol, const int& half, meMedianState* state)
+{
+	auto& state_ = *state;
+
+	int newLeft = std::max(0, centerCol - half);
+	int newRight = std::min(frame.cols, centerCol + half + 1);
+	const uint16_t* columnHistPtr = state_.ColumnHistograms.data();
+	uint16_t* kernelHistPtr = state_.KernelHistogram.data();
+
+	for (int c = state_.KernelLeft; c < state_.KernelRight; c++)
+	{
+		if ((c >= newLeft) && (c < newRight)) continue;
+		subHistogram(kernelHistPtr, columnHistPtr + c * MEDIAN_BINS);
+	}
+	for (int c = newLeft; c < newRight; c++)
+	{
+		if ((c >= state_.KernelLeft) && (c < state_.KernelRight)) continue;
+		addHistogram(kernelHistPtr, columnHistPtr + c * MEDIAN_BINS);
+	}
+
+	state_.KernelLeft = newLeft;
+	state_.KernelRight = newRight;
+
+	int correct = (state_.HistogramBottom - state_.HistogramTop) * (newRight - newLeft);
+	int rank = (correct + 1) / 2;
+	int cumulative = 0;
+	for (int v = 0; v < MEDIAN_BINS; v++)
+	{
+		cumulative += kernelHistPtr[v];
+		if (cumulative >= rank)
+		{
+			return (uint8_t)v;
+		}
+	}
+
+	return 0xFF;
+}
+
+// 带 Ѹ PushThroughImage ׸ ޵   ȼ ȯѴ.
+//HSVedFrame nullptr ѱ涧 ȴ. HSV  ü ޶ ϸ ü ȯؾ ϹǷ  带  ʴ´
+void ColorDetection::SetSparseEvaluation(const bool& isSparseEvaluation)
+{
+	mbSparseEvaluation = isSparseEvaluation;
+}
+
+// PushThroughImage  ȯ ȼ . ü ȯ̸  ȼ 
+int ColorDetection::GetLastTouchedPixelCount()
+{
+	return mLastTouchedPixelCount;
+}
+
+//׸ ޵  . Median_Sort  DoMedianBlur( ), Median_Histogram  ׷ 
+void ColorDetection::SetMedianEngine(const eMedianEngine& medianEngine)
+{
+	mMedianEngine = medianEngine;
+}
+
+//÷ ʿ ڽ  . Labeling_FloodFill(⺻)  ť , Labeling_UnionFind   Ͽ ε.
+//Ͽ ε ÷ ڽ ŭ ǳʶٴ ĵ  Ƿ ڽ  ٸ  ִ(CompareColorLabelingExperiment).
+//threadCount ū ׸忡 Ͽ ε带    ̰, 0̸ ھ  
+void ColorDetection::SetLabelingEngine(const eLabelingEngine& labelingEngine, const int& threadCount)
+{
+	mLabelingEngine = labelingEngine;
+	mLabelingThreadCount = threadCount;
+}
+
+//PushThroughImage   ()  . 1̸ ó  , 0̸ ھ 
+void ColorDetection::SetBandThreadCount(const int& threadCount)
+{
+	int bandThreadCount = (threadCount > 0) ? threadCount : std::max(1, (int)std::thread::hardware_concurrency());
+	if (bandThreadCount == mBandThreadCount)
+	{
+		return;
+	}
+
+	mBandThreadCount = bandThreadCount;
+	mBandPool = (bandThreadCount > 1) ? std::make_shared<ThreadPool>(bandThreadCount) : nullptr;
+}
+
+int ColorDetection::GetBandThreadCount()
+{
+	return mBandThreadCount;
+}
+
+//Ÿ 带 Ѹ PushThroughImage tileCacheBytes(L2 ũ)  Ÿϸ ȯ ׸ ޵ ̾ Ѵ
+void ColorDetection::SetTiledExecution(const bool& isTiledExecution, const int& tileCacheBytes)
+{
+	mbTiledExecution = isTiledExecution;
+	mTileCacheBytes = tileCacheBytes;
+}
+
+//PushThroughImage ߰ (÷ , hue , ޵  ) â ̹  Ҵ.
+//   ü ٽ а ڵϹǷ , Ÿ  ӵ  
+void ColorDetection::SetDebugDisplay(const bool& isDebugDisplay)
+{
+	mbDebugDisplay = isDebugDisplay;
+}
+
+bool ColorDetection::IsDebugDisplay()
+{
+	return mbDebugDisplay;
+}
+
+//ٿø ׸   ޵ ؼ gridFrame(׸  x ׸ ) ִ´. ιڽüĿ  ʴ´.
+//  ӵ,  񱳿
+void ColorDetection::DoGridMedianBlur(const cv::Mat& frame, cv::Mat* gridFrame, const eMedianEngine& medianEngine)
+{
+	auto& gridFrame_ = *gridFrame;
+
+	int medianBlurHalf = mMedianBlurSize / 2;
+	int gridRows = (frame.rows - mDownSamplingSize_Half - 1) / mDownSamplingSize + 1;
+	int gridCols = (frame.cols - mDownSamplingSize_Half - 1) / mDownSamplingSize + 1;
+	gridFrame_.create(gridRows, gridCols, CV_8UC1);
+
+	cv::Mat frame_ = frame;
+	if (medianEngine == Median_Histogram)
+	{
+		resetMedianHistograms(frame_, &mMedianState);
+	}
+
+	for (int gr = 0; gr < gridRows; gr++)
+	{
+		int r = mDownSamplingSize_Half + gr * mDownSamplingSize;
+		uchar* gridFramePtr = gridFrame_.ptr(gr);
+
+		if (medianEngine == Median_Histogram)
+		{
+			beginMedianRow(frame_, r, medianBlurHalf, &mMedianState);
+		}
+
+		for (int gc = 0; gc < gridCols; gc++)
+		{
+			int c = mDownSamplingSize_Half + gc * mDownSamplingSize;
+			gridFramePtr[gc] = (medianEngine == Median_Histogram) ? getHistogramMedian(frame_, c, medianBlurHalf, &mMedianState)
+				: DoMedianBlur(&frame_, cv::Point(c, r), medianBlurHalf);
+		}
+	}
+}
+
+//׸尡  ĭ  ũ Ͽ ε 󺧸   . ػ ī޶
+static const int PARALLEL_LABELING_MIN_CELLS = 65536;
+
+// row  ׸  ߿ ޵   ( , ÷ )  rowPlan ִ´.
+//ιڽüĿ ڽ ɸ  ڽ ŭ ǳʶٸ, ǳʶ  ÷    MakeBoxWithMedianBlur ״̴
+void ColorDetection::makeGridRowPlan(const int& row, const int& frameCols, InBoxChecker* inBoxChecker, std::vector<std::pair<int, int>>* rowPlan)
+{
+	auto& inBoxChecker_ = *inBoxChecker;
+	auto& rowPlan_ = *rowPlan;
+
+	rowPlan_.clear();
+	int jumpingWidth = 0;
+	int flagCol = 1;
+	for (int c = mDownSamplingSize_Half; c < frameCols; c += mDownSamplingSize)
+	{
+		if (inBoxChecker_.CheckInBox(cv::Point(c, row), &jumpingWidth))
+		{
+			c = c + ((((jumpingWidth) / mDownSamplingSize) + 1) * mDownSamplingSize);
+			flagCol = ((c - 4) / mDownSamplingSize) + 1;
+			flagCol++;
+			continue;
+		}
+		rowPlan_.push_back(std::make_pair(c, flagCol));
+		flagCol++;
+	}
+}
+
+//׸  [gridRowBegin, gridRowEnd) ޵ ÷  (׸  + 1)࿡ ִ´. ιڽüĿ ڽ   ǳʶڴ.
+//hueDetectedFrame  frameTop    ǹǷ, 帶 ڱ (+ҷ )   ѱ  ִ
+void ColorDetection::makeFlagRows(const cv::Mat& hueDetectedFrame, const int& frameTop, const int& gridRowBegin, const int& gridRowEnd,
+	cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker, meMedianState* medianState)
+{
+	auto& boxFlagFrame_ = *boxFlagFrame;
+	auto& medianState_ = *medianState;
+
+	int medianBlurHalf = mMedianBlurSize / 2;
+	bool isHistogramEngine = (mMedianEngine == Median_Histogram);
+	medianState_.SortBuffer.resize((size_t)mMedianBlurSize * mMedianBlurSize);
+
+	for (int gr = gridRowBegin; gr < gridRowEnd; gr++)
+	{
+		//r  ǥ, frameRow hueDetectedFrame  
+		int r = mDownSamplingSize_Half + gr * mDownSamplingSize;
+		int frameRow = r - frameTop;
+		uchar* boxFlagFramePtr = boxFlagFrame_.ptr(gr + 1);
+
+		if (isHistogramEngine)
+		{
+			beginMedianRow(hueDetectedFrame, frameRow, medianBlurHalf, &medianState_);
+		}
+
+		makeGridRowPlan(r, hueDetectedFrame.cols, inBoxChecker, &medianState_.RowPlan);
+		for (size_t k = 0; k < medianState_.RowPlan.size(); k++)
+		{
+			int c = medianState_.RowPlan[k].first;
+			boxFlagFramePtr[medianState_.RowPlan[k].second] = isHistogramEngine ? getHistogramMedian(hueDetectedFrame, c, medianBlurHalf, &medianState_)
+				: getSortMedian(hueDetectedFrame, cv::Point(c, frameRow), medianBlurHalf, &medianState_.SortBuffer);
+		}
+	}
+}
+
+// ä ÷ ʿ 󺧸  ڽ  ιڽüĿ Ѵ. ȯ   ȼ 
+int ColorDetection::makeBoxFromFlagFrame(cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker,
+	const int& originalBoxRows, const int& originalBoxCols, const std::string& name)
+{
+	auto& boxFlagFrame_ = *boxFlagFrame;
+
+	if (mLabelingEngine == Labeling_FloodFill)
+	{
+		return MakeBoxWithFloodFill(&boxFlagFrame_, inBoxChecker, originalBoxRows, originalBoxCols, name);
+	}
+
+	//ū ׸常  .  ׸ 忡 ִ   ũ
+	int labelingThreadCount = (mLabelingThreadCount > 0) ? mLabelingThreadCount : (int)std::thread::hardware_concurrency();
+	if ((boxFlagFrame_.rows - 2) * (boxFlagFrame_.cols - 2) < PARALLEL_LABELING_MIN_CELLS) labelingThreadCount = 1;
+	return MakeBoxWithUnionFind(&boxFlagFrame_, inBoxChecker, originalBoxRows, originalBoxCols, name, labelingThreadCount);
+}
+
+//޵  ؼ ڽ . δ FloodFill ˰ Ǿ.
+int ColorDetection::MakeBoxWithMedianBlur(cv::Mat* hueDetectedFrame, cv::Mat* boxFlagFrame, 
+	InBoxChecker* inBoxChecker,const std::string& name)
+{
+	auto& hueDetectedFrame_ = *hueDetectedFrame;
+	auto& boxFlagFrame_ = *boxFlagFrame;
+	auto& inBoxChecker_ = *inBoxChecker;
+
+	int gridRows = (hueDetectedFrame_.rows > mDownSamplingSize_Half) ? (hueDetectedFrame_.rows - mDownSamplingSize_Half - 1) / mDownSamplingSize + 1 : 0;
+	if (mMedianEngine == Median_Histogram)
+	{
+		resetMedianHistograms(hueDetectedFrame_, &mMedianState);
+	}
+	makeFlagRows(hueDetectedFrame_, 0, 0, gridRows, &boxFlagFrame_, &inBoxChecker_, &mMedianState);
+
+	return makeBoxFromFlagFrame(&boxFlagFrame_, &inBoxChecker_, hueDetectedFrame_.rows, hueDetectedFrame_.cols, name);
+};
+
+//    hue , ׸ ޵,   帶  Ǯ ѹ .
+// ׸   , ޵ 찡 Ʒ  Ѿ ҷ  帶  ȯѴ.
+//÷  帶 ڱ ุ ,  迡 ģ Ʈ Ͽ ε տ ̾ δ.
+//  帶 ڱ ׸  ޵ 츸 ȯϰ, ÷ 󺧸̸ 尡      󺧸Ѵ.
+//hueMappedFrame nullptr ƴϸ 尡    ü hue ӵ ( ǥÿ).
+// PushThroughImage   ο . ȯ   ȼ 
+int ColorDetection::MakeBoxWithBands(const cv::Mat& BGRFrame, cv::Mat* hueMappedFrame, cv::Mat* boxFlagFrame,
+	InBoxChecker* inBoxChecker, const int& detectionIndex)
+{
+	auto& boxFlagFrame_ = *boxFlagFrame;
+
+	int gridRows = (BGRFrame.rows > mDownSamplingSize_Half) ? (BGRFrame.rows - mDownSamplingSize_Half - 1) / mDownSamplingSize + 1 : 0;
+	int gridCols = (BGRFrame.cols > mDownSamplingSize_Half) ? (BGRFrame.cols - mDownSamplingSize_Half - 1) / mDownSamplingSize + 1 : 0;
+	if (hueMappedFrame != nullptr)
+	{
+		hueMappedFrame->create(BGRFrame.rows, BGRFrame.cols, CV_8UC1);
+	}
+	boxFlagFrame_ = cv::Mat::zeros(gridRows + 2, gridCols + 2, CV_8UC1);
+	mLastTouchedPixelCount = 0;
+	if (gridRows == 0)
+	{
+		return 0;
+	}
+
+	//󺧸 ǳʶ ĭ 带   ִ ڽ Ѵ
+	bool isUnionFind = (mLabelingEngine == Labeling_UnionFind);
+	if (isUnionFind)
+	{
+		makeLabelSkipBits(boxFlagFrame_, inBoxChecker);
+	}
+
+	int bandCount = std::min(mBandThreadCount, gridRows);
+	std::vector<meLabelStrip> strips(bandCount);
+	std::vector<int> touchedPixelCounts(bandCount, 0);
+	mBandMedianStates.resize(bandCount);
+	mBandHueFrames.resize(bandCount);
+	mBandColumnMasks.resize(bandCount);
+
+	int medianBlurHalf = mMedianBlurSize / 2;
+	const uint8_t* tablePtr = mHueDetectionRanges[detectionIndex].mHueSatTable.data();
+
+	auto runBand = [&](int b)
+	{
+		int gridRowBegin = (gridRows * b) / bandCount;
+		int gridRowEnd = (gridRows * (b + 1)) / bandCount;
+
+		//尡 ô  , ޵   ȯ 
+		int ownTop = (b == 0) ? 0 : gridRowBegin * mDownSamplingSize;
+		int ownBottom = (b == bandCount - 1) ? BGRFrame.rows : gridRowEnd * mDownSamplingSize;
+		int windowTop = std::max(0, mDownSamplingSize_Half + gridRowBegin * mDownSamplingSize - medianBlurHalf);
+		int windowBottom = std::min(BGRFrame.rows, mDownSamplingSize_Half + (gridRowEnd - 1) * mDownSamplingSize + medianBlurHalf + 1);
+		int bandTop = std::min(ownTop, windowTop);
+		int bandBottom = std::max(ownBottom, windowBottom);
+
+		cv::Mat& bandFrame = mBandHueFrames[b];
+		bandFrame.create(bandBottom - bandTop, BGRFrame.cols, CV_8UC1);
+		if (mbSparseEvaluation)
+		{
+			//ȯ ʴ ȼ    ó 0 д
+			bandFrame.setTo(cv::Scalar(0));
+			touchedPixelCounts[b] = mapHueRowsSparse(BGRFrame, bandTop, gridRowBegin, gridRowEnd, inBoxChecker, tablePtr, &bandFrame,
+				&mBandColumnMasks[b], &mBandMedianStates[b].RowPlan);
+		}
+		else
+		{
+			for (int r = bandTop; r < bandBottom; r++)
+			{
+				uchar* bandFramePtr = bandFrame.ptr(r - bandTop);
+				mapHueRowFromBGR(BGRFrame.ptr<uchar>(r), 0, BGRFrame.cols, 1, &tablePtr, &bandFramePtr, nullptr);
+			}
+			touchedPixelCounts[b] = bandFrame.rows * bandFrame.cols;
+		}
+
+		//尡  ุ ü hue ӿ Ѵ. ҷ   尡 
+		if (hueMappedFrame != nullptr)
+		{
+			for (int r = ownTop; r < ownBottom; r++)
+			{
+				memcpy(hueMappedFrame->ptr(r), bandFrame.ptr(r - bandTop), BGRFrame.cols);
+			}
+		}
+
+		if (mMedianEngine == Median_Histogram)
+		{
+			resetMedianHistograms(bandFrame, &mBandMedianStates[b]);
+		}
+		makeFlagRows(bandFrame, bandTop, gridRowBegin, gridRowEnd, &boxFlagFrame_, inBoxChecker, &mBandMedianStates[b]);
+
+		if (isUnionFind)
+		{
+			strips[b].RowBegin = gridRowBegin + 1;
+			strips[b].RowEnd = gridRowEnd + 1;
+			labelStripRuns(boxFlagFrame_, &strips[b]);
+		}
+	};
+
+	if ((mBandPool != nullptr) && (bandCount > 1))
+	{
+		mBandPool->ParallelFor(bandCount, runBand);
+	}
+	else
+	{
+		for (int b = 0; b < bandCount; b++)
+		{
+			runBand(b);
+		}
+	}
+
+	//ҷ  ļ ȯ ȼ 
+	for (int b = 0; b < bandCount; b++)
+	{
+		mLastTouchedPixelCount += touchedPixelCounts[b];
+	}
+
+	//÷ ÷  ü ѹ Ⱦ ϹǷ 尡   ڿ Ѵ
+	if (isUnionFind == false)
+	{
+		return MakeBoxWithFloodFill(&boxFlagFrame_, inBoxChecker, BGRFrame.rows, BGRFrame.cols, mHueDetectionRanges[detectionIndex].mName);
+	}
+
+	return addBoxesFromLabelStrips(&strips, boxFlagFrame_.cols, inBoxChecker, BGRFrame.rows, BGRFrame.cols,
+		mHueDetectionRanges[detectionIndex].mName);
+}
+
+//ĳ ũ  Ÿϸ BGR -> hue ΰ ׸ ޵ ̾ ؼ, Ÿ L2 ִ   ܰ谡 а Ѵ.
+//hue  ü  ʰ ÷ ʸ . Ÿ ޵ 찡 Ѿ ҷ ȼ ȯϸ,
+// 尡  Ÿ   Ǯ ش.  MakeBoxWithMedianBlur . ȯ   ȼ 
+int ColorDetection::MakeBoxWithTiles(const cv::Mat& BGRFrame, cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker, const int& detectionIndex)
+{
+	auto& boxFlagFrame_ = *boxFlagFrame;
+
+	int gridRows = (BGRFrame.rows > mDownSamplingSize_Half) ? (BGRFrame.rows - mDownSamplingSize_Half - 1) / mDownSamplingSize + 1 : 0;
+	int gridCols = (BGRFrame.cols > mDownSamplingSize_Half) ? (BGRFrame.cols - mDownSamplingSize_Half - 1) / mDownSamplingSize + 1 : 0;
+	boxFlagFrame_ = cv::Mat::zeros(gridRows + 2, gridCols + 2, CV_8UC1);
+	mLastTouchedPixelCount = 0;
+	if ((gridRows == 0) || (gridCols == 0))
+	{
+		return 0;
+	}
+
+	//ιڽüĿ ˻   ó ̾ ؾ  Ƿ, ׸ ึ ޵    صд
+	mGridRowPlans.resize(gridRows);
+	for (int gr = 0; gr < gridRows; gr++)
+	{
+		makeGridRowPlan(mDownSamplingSize_Half + gr * mDownSamplingSize, BGRFrame.cols, inBoxChecker, &mGridRowPlans[gr]);
+	}
+
+	//Ÿ   L(ȼ) BGR 3Ʈ + hue 1Ʈ +  ׷( MEDIAN_BINS * 2Ʈ) ĳÿ  Ѵ.
+	//4L^2 + 512L <= mTileCacheBytes
+	int medianBlurHalf = mMedianBlurSize / 2;
+	double tileSide = (std::sqrt(512.0 * 512.0 + 16.0 * mTileCacheBytes) - 512.0) / 8.0;
+	int tileGridSize = std::max(1, ((int)tileSide - 2 * medianBlurHalf) / mDownSamplingSize);
+	int tileRowCount = (gridRows + tileGridSize - 1) / tileGridSize;
+	int tileColCount = (gridCols + tileGridSize - 1) / tileGridSize;
+
+	mTileMedianStates.resize(tileRowCount);
+	mTileHueFrames.resize(tileRowCount);
+	std::vector<int> touchedPixelCounts(tileRowCount, 0);
+
+	const uint8_t* tablePtr = mHueDetectionRanges[detectionIndex].mHueSatTable.data();
+	bool isHistogramEngine = (mMedianEngine == Median_Histogram);
+
+	auto runTileRow = [&](int tr)
+	{
+		meMedianState& medianState = mTileMedianStates[tr];
+		cv::Mat& tileFrame = mTileHueFrames[tr];
+		medianState.SortBuffer.resize((size_t)mMedianBlurSize * mMedianBlurSize);
+
+		int gridRowBegin = tr * tileGridSize;
+		int gridRowEnd = std::min(gridRows, gridRowBegin + tileGridSize);
+		int tileTop = std::max(0, mDownSamplingSize_Half + gridRowBegin * mDownSamplingSize - medianBlurHalf);
+		int tileBottom = std::min(BGRFrame.rows, mDownSamplingSize_Half + (gridRowEnd - 1) * mDownSamplingSize + medianBlurHalf + 1);
+
+		//׸ ึ  ŸϿ  ȹ ġ
+		std::vector<size_t> planCursors(gridRowEnd - gridRowBegin, 0);
+
+		for (int tc = 0; tc < tileColCount; tc++)
+		{
+			int gridColBegin = tc * tileGridSize;
+			int gridColEnd = std::min(gridCols, gridColBegin + tileGridSize);
+			int lastCol = mDownSamplingSize_Half + (gridColEnd - 1) * mDownSamplingSize;
+			int tileLeft = std::max(0, mDownSamplingSize_Half + gridColBegin * mDownSamplingSize - medianBlurHalf);
+			int tileRight = std::min(BGRFrame.cols, lastCol + medianBlurHalf + 1);
+
+			//Ÿ ȼ hue 
+			tileFrame.create(tileBottom - tileTop, tileRight - tileLeft, CV_8UC1);
+			for (int r = tileTop; r < tileBottom; r++)
+			{
+				uchar* tileFramePtr = tileFrame.ptr(r - tileTop);
+				mapHueRowFromBGR(BGRFrame.ptr<uchar>(r) + tileLeft * 3, 0, tileRight - tileLeft, 1, &tablePtr, &tileFramePtr, nullptr);
+			}
+			touchedPixelCounts[tr] += tileFrame.rows * tileFrame.cols;
+
+			//ĳÿ ִ ŸϿ ٷ ׸ ޵  ÷ ʿ 
+			if (isHistogramEngine)
+			{
+				resetMedianHistograms(tileFrame, &medianState);
+			}
+			for (int gr = gridRowBegin; gr < gridRowEnd; gr++)
+			{
+				const std::vector<std::pair<int, int>>& rowPlan = mGridRowPlans[gr];
+				size_t& k = planCursors[gr - gridRowBegin];
+				if ((k >= rowPlan.size()) || (rowPlan[k].first > lastCol)) continue;
+
+				int frameRow = mDownSamplingSize_Half + gr * mDownSamplingSize - tileTop;
+				uchar* boxFlagFramePtr = boxFlagFrame_.ptr(gr + 1);
+				if (isHistogramEngine)
+				{
+					beginMedianRow(tileFrame, frameRow, medianBlurHalf, &medianState);
+				}
+
+				for (; (k < rowPlan.size()) && (rowPlan[k].first <= lastCol); k++)
+				{
+					int c = rowPlan[k].first - tileLeft;
+					boxFlagFramePtr[rowPlan[k].second] = isHistogramEngine ? getHistogramMedian(tileFrame, c, medianBlurHalf, &medianState)
+						: getSortMedian(tileFrame, cv::Point(c, frameRow), medianBlurHalf, &medianState.SortBuffer);
+				}
+			}
+		}
+	};
+
+	if ((mBandPool != nullptr) && (mBandThreadCount > 1) && (tileRowCount > 1))
+	{
+		mBandPool->ParallelFor(tileRowCount, runTileRow);
+	}
+	else
+	{
+		for (int tr = 0; tr < tileRowCount; tr++)
+		{
+			runTileRow(tr);
+		}
+	}
+
+	//ҷ  ļ ȯ ȼ 
+	for (int tr = 0; tr < tileRowCount; tr++)
+	{
+		mLastTouchedPixelCount += touchedPixelCounts[tr];
+	}
+
+	return makeBoxFromFlagFrame(&boxFlagFrame_, inBoxChecker, BGRFrame.rows, BGRFrame.cols, mHueDetectionRanges[detectionIndex].mName);
+}
+
+//ѹ    ڽ÷׸Ʈ ̿ؼ ڽ  ιڽüĿ ϴ Լ
+//ȯ   ȼ ̴.
+int ColorDetection::MakeBoxWithFloodFill(cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker, 
+	const int& originalBoxRows, const int& originalBoxCols, const std::string& name)
+{
+	auto& boxFlagFrame_ = *boxFlagFrame;
+	auto& inBoxChecker_ = *inBoxChecker;
+
+	uchar* boxFlagFramePtr;
+
+	std::queue<cv::Point> pointQue;
+	uchar val;
+	int addWidth;
+
+	cv::Point curPt;
+
+	cv::Point pt_Up;
+	cv::Point pt_Down;
+	cv::Point pt_Left;
+	cv::Point pt_Right;
+
+	cv::Point pt_UpLeft;
+	cv::Point pt_DownRight;
+
+	int totalDetectedPixel = 0;
+
+	for (int r = 1; r < boxFlagFrame_.rows - 1; r++)
+	{
+		boxFlagFramePtr = boxFlagFrame_.ptr(r);
+		for (int c = 1; c < boxFlagFrame_.cols - 1; c++)
+		{
+			//̹ ִ ڽ Եȴٸ  ѱ
+			if (inBoxChecker_.CheckInBox(cv::Point((c - 1) * mDownSamplingSize + mDownSamplingSize_Half,
+				(r - 1) * mDownSamplingSize + mDownSamplingSize_Half), &addWidth))
+			{
+				c = c + ((addWidth / mDownSamplingSize) + 1);
+				continue;
+			}
+
+			val = boxFlagFramePtr[c];
+
+			//floodfill 
+			if (val > 0)
+			{
+				// Ⱥ ִٸ      ̹Ƿ..  Ӱ ʱȭ ʿ ڴ.
+				pointQue.push(cv::Point(c, r));
+
+				pt_UpLeft = cv::Point(c, r);
+				pt_DownRight = cv::Point(c, r);
+
+				boxFlagFrame_.at<uchar>(cv::Point(c, r)) += 0x80;
+
+				while (pointQue.empty() == false)
+				{
+					//ϴ ȼ Ǿ ϳ ߰ϰ 
+					totalDetectedPixel++;
+
+					curPt = pointQue.front();
+					pointQue.pop();
+
+					pt_Up = curPt;
+					pt_Up.y -= 1;
+
+					pt_Down = curPt;
+					pt_Down.y += 1;
+
+					pt_Left = curPt;
+					pt_Left.x -= 1;
+
+					pt_Right = curPt;
+					pt_Right.x += 1;
+
+					// ˻,  Ʈ 128 ǹϴ Ʈ ϴ ˻Ѵ. ̰ ü flag Ѵ.
+					if (boxFlagFrame_.at<uchar>(pt_Right) > 0)
+					{
+						if ((boxFlagFrame_.at<uchar>(pt_Right) >> 7) == 0x00)
+						{
+							//˻簡 ȵǾ־ٸ, ť Ӱ ְ,
+							pointQue.push(pt_Right);
+							if (pt_Right.x > pt_DownRight.x) pt_DownRight.x = pt_Right.x;
+							boxFlagFrame_.at<uchar>(pt_Right) += 0x80;
+						}
+					}
+					//Ʒ ˻
+					if (boxFlagFrame_.at<uchar>(pt_Down) > 0)
+					{
+						if ((boxFlagFrame_.at<uchar>(pt_Down) >> 7) == 0x00)
+						{
+							pointQue.push(pt_Down);
+							if (pt_Down.y > pt_DownRight.y) pt_DownRight.y = pt_Down.y;
+							boxFlagFrame_.at<uchar>(pt_Down) += 0x80;
+						}
+					}
+					// ˻
+					if (boxFlagFrame_.at<uchar>(pt_Left) > 0)
+					{
+						if ((boxFlagFrame_.at<uchar>(pt_Left) >> 7) == 0x00)
+						{
+							pointQue.push(pt_Left);
+							if (pt_Left.x < pt_UpLeft.x) pt_UpLeft.x = pt_Left.x;
+							boxFlagFrame_.at<uchar>(pt_Left) += 0x80;
+						}
+					}
+					// ˻
+					if (boxFlagFrame_.at<uchar>(pt_Up) > 0)
+					{
+						if ((boxFlagFrame_.at<uchar>(pt_Up) >> 7) == 0x00)
+						{
+							pointQue.push(pt_Up);
+							if (pt_Up.y < pt_UpLeft.y) pt_UpLeft.y = pt_Up.y;
+							boxFlagFrame_.at<uchar>(pt_Up) += 0x80;
+						}
+					}
+				}
+
+				//ڽ  ũ+ѿ ĭ  鸮
+				pt_UpLeft = (pt_UpLeft - cv::Point(2, 2)) * mDownSamplingSize + cv::Point(mDownSamplingSize_Half, mDownSamplingSize_Half);
+				pt_DownRight = (pt_DownRight * mDownSamplingSize + cv::Point(mDownSamplingSize_Half, mDownSamplingSize_Half));
+
+				//    ʾҴ ˻
+				if (pt_UpLeft.x < 0) pt_UpLeft.x = 0;
+				if (pt_UpLeft.y < 0) pt_UpLeft.y = 0;
+				if (pt_DownRight.x > originalBoxCols - 1) pt_DownRight.x = originalBoxCols - 1;
+				if (pt_DownRight.y > originalBoxRows - 1) pt_DownRight.y = originalBoxRows - 1;
+
+
+
+				cv::Rect newRect = cv::Rect(pt_UpLeft, pt_DownRight);
+				inBoxChecker_.AddBox(newRect, InBoxChecker::ColorDetection, name);
+
+
+			}
+
+		}
+	}
+
+	//ѹ  ȼ      .
+	// ÷׸ ٿø  ̿Ͽ, ÷׸ 1ĭ ٿø^2 ȼ Ѱ Ѵ.
+	//ӵ ,  Ȯ پ Ʈ̵  .
+	totalDetectedPixel = totalDetectedPixel * mDownSamplingSize * mDownSamplingSize;
+
+	return totalDetectedPixel;
+};
+
+//Ͽ ε. Ʈ ׻  ( )  ǵ Ѵ
+static inline int findLabelRoot(std::vector<int>* parents, int index)
+{
+	auto& parents_ = *parents;
+	while (parents_[index] != index)
+	{
+		parents_[index] = parents_[parents_[index]];
+		index = parents_[index];
+	}
+	return index;
+}
+
+static inline void unionLabelRoots(std::vector<int>* parents, const int& a, const int& b)
+{
+	int rootA = findLabelRoot(parents, a);
+	int rootB = findLabelRoot(parents, b);
+	if (rootA < rootB) (*parents)[rootB] = rootA;
+	else if (rootB < rootA) (*parents)[rootA] = rootB;
+}
+
+//󺧸  ιڽüĿ ִ ڽ  ÷ ĭ Ʈ .
+//÷ ĭ (r, c)  ǥ ((c - 1) * ٿø + half, (r - 1) * ٿø + half) شѴ
+void ColorDetection::makeLabelSkipBits(const cv::Mat& boxFlagFrame, InBoxChecker* inBoxChecker)
+{
+	auto& inBoxChecker_ = *inBoxChecker;
+
+	int cellCount = boxFlagFrame.rows * boxFlagFrame.cols;
+	mLabelSkipBits.assign((cellCount + 63) / 64, 0);
+
+	int boxCount = inBoxChecker_.GetBoxCount();
+	for (int i = 0; i < boxCount; i++)
+	{
+		cv::Rect box = inBoxChecker_.GetBox(i).Box;
+
+		//ڽ ȿ  ׸  . ׸  ǥ = index * ٿø + half
+		int firstRow = (box.y <= mDownSamplingSize_Half) ? 0 : (box.y - mDownSamplingSize_Half + mDownSamplingSize - 1) / mDownSamplingSize;
+		int firstCol = (box.x <= mDownSamplingSize_Half) ? 0 : (box.x - mDownSamplingSize_Half + mDownSamplingSize - 1) / mDownSamplingSize;
+		int lastY = box.y + box.height - 1;
+		int lastX = box.x + box.width - 1;
+		if ((lastY < mDownSamplingSize_Half) || (lastX < mDownSamplingSize_Half)) continue;
+		int lastRow = std::min((lastY - mDownSamplingSize_Half) / mDownSamplingSize, boxFlagFrame.rows - 3);
+		int lastCol = std::min((lastX - mDownSamplingSize_Half) / mDownSamplingSize, boxFlagFrame.cols - 3);
+
+		for (int r = firstRow; r <= lastRow; r++)
+		{
+			int bitIndex = (r + 1) * boxFlagFrame.cols + firstCol + 1;
+			for (int c = firstCol; c <= lastCol; c++, bitIndex++)
+			{
+				mLabelSkipBits[bitIndex >> 6] |= (uint64_t)1 << (bitIndex & 63);
+			}
+		}
+	}
+}
+
+// (strip)  ÷ 鿡 0 ƴ ĭ  ̰,     ġ ģ (4 )
+void ColorDetection::labelStripRuns(const cv::Mat& boxFlagFrame, meLabelStrip* strip)
+{
+	auto& strip_ = *strip;
+
+	strip_.Runs.clear();
+	strip_.Parents.clear();
+	strip_.FirstRowRunEnd = 0;
+	strip_.LastRowRunBegin = 0;
+
+	int lastCol = boxFlagFrame.cols - 1;
+	int prevRowBegin = 0;
+	int prevRowEnd = 0;
+
+	for (int r = strip_.RowBegin; r < strip_.RowEnd; r++)
+	{
+		const uchar* boxFlagFramePtr = boxFlagFrame.ptr(r);
+		int rowBegin = (int)strip_.Runs.size();
+		int prevCursor = prevRowBegin;
+
+		int c = 1;
+		while (c < lastCol)
+		{
+			if (boxFlagFramePtr[c] == 0)
+			{
+				c++;
+				continue;
+			}
+
+			meLabelRun run;
+			run.Row = r;
+			run.Start = c;
+			run.Seed = -1;
+			int bitIndex = r * boxFlagFrame.cols + c;
+			for (; (c < lastCol) && (boxFlagFramePtr[c] != 0); c++, bitIndex++)
+			{
+				if ((run.Seed < 0) && (((mLabelSkipBits[bitIndex >> 6] >> (bitIndex & 63)) & 1) == 0))
+				{
+					run.Seed = c;
+				}
+			}
+			run.End = c - 1;
+
+			int runIndex = (int)strip_.Runs.size();
+			strip_.Runs.push_back(run);
+			strip_.Parents.push_back(runIndex);
+
+			// ࿡        ĥ   ǳʶڴ
+			while ((prevCursor < prevRowEnd) && (strip_.Runs[prevCursor].End < run.Start)) prevCursor++;
+			for (int p = prevCursor; (p < prevRowEnd) && (strip_.Runs[p].Start <= run.End); p++)
+			{
+				unionLabelRoots(&strip_.Parents, p, runIndex);
+			}
+		}
+
+		if (r == strip_.RowBegin) strip_.FirstRowRunEnd = (int)strip_.Runs.size();
+		strip_.LastRowRunBegin = rowBegin;
+		prevRowBegin = rowBegin;
+		prevRowEnd = (int)strip_.Runs.size();
+	}
+}
+
+//  ϳ Ͽ ε ,  迡 ´  ̾  
+//Ʈ ڽ ĭ  ؼ ιڽüĿ Ѵ. ȯ   ȼ 
+int ColorDetection::addBoxesFromLabelStrips(std::vector<meLabelStrip>* strips, const int& flagCols, InBoxChecker* inBoxChecker,
+	const int& originalBoxRows, const int& originalBoxCols, const std::string& name)
+{
+	auto& strips_ = *strips;
+	auto& inBoxChecker_ = *inBoxChecker;
+
+	std::vector<int> runOffsets(strips_.size() + 1, 0);
+	for (size_t s = 0; s < strips_.size(); s++)
+	{
+		runOffsets[s + 1] = runOffsets[s] + (int)strips_[s].Runs.size();
+	}
+
+	std::vector<int> parents(runOffsets.back());
+	for (size_t s = 0; s < strips_.size(); s++)
+	{
+		for (size_t i = 0; i < strips_[s].Parents.size(); i++)
+		{
+			parents[runOffsets[s] + i] = strips_[s].Parents[i] + runOffsets[s];
+		}
+	}
+
+	// :        ù   ģ
+	for (size_t s = 1; s < strips_.size(); s++)
+	{
+		auto& upper = strips_[s - 1];
+		auto& lower = strips_[s];
+		if ((upper.RowEnd != lower.RowBegin) || upper.Runs.empty() || lower.Runs.empty()) continue;
+		if (upper.Runs.back().Row != upper.RowEnd - 1) continue;
+
+		int u = upper.LastRowRunBegin;
+		for (int l = 0; l < lower.FirstRowRunEnd; l++)
+		{
+			while ((u < (int)upper.Runs.size()) && (upper.Runs[u].End < lower.Runs[l].Start)) u++;
+			for (int p = u; (p < (int)upper.Runs.size()) && (upper.Runs[p].Start <= lower.Runs[l].End); p++)
+			{
+				unionLabelRoots(&parents, runOffsets[s - 1] + p, runOffsets[s] + l);
+			}
+		}
+	}
+
+	//Ʈ ڽ ĭ  , Ʈ     
+	struct LabelComponent { cv::Point UpLeft; cv::Point DownRight; int CellCount; int RunBegin; int RunCount; int CursorRun; int CursorCol; };
+	std::vector<int> componentIndices(parents.size(), -1);
+	std::vector<int> runComponents(parents.size());
+	std::vector<LabelComponent> components;
+
+	for (size_t s = 0; s < strips_.size(); s++)
+	{
+		for (size_t i = 0; i < strips_[s].Runs.size(); i++)
+		{
+			const meLabelRun& run = strips_[s].Runs[i];
+			int root = findLabelRoot(&parents, runOffsets[s] + (int)i);
+			if (componentIndices[root] < 0)
+			{
+				componentIndices[root] = (int)components.size();
+				components.push_back({ cv::Point(run.Start, run.Row), cv::Point(run.End, run.Row), 0, 0, 0, 0, 0 });
+			}
+
+			LabelComponent& component = components[componentIndices[root]];
+			component.UpLeft.x = std::min(component.UpLeft.x, run.Start);
+			component.UpLeft.y = std::min(component.UpLeft.y, run.Row);
+			component.DownRight.x = std::max(component.DownRight.x, run.End);
+			component.DownRight.y = std::max(component.DownRight.y, run.Row);
+			component.CellCount += run.End - run.Start + 1;
+			component.RunCount++;
+			runComponents[runOffsets[s] + i] = componentIndices[root];
+		}
+	}
+
+	int runBegin = 0;
+	for (size_t k = 0; k < components.size(); k++)
+	{
+		components[k].RunBegin = runBegin;
+		runBegin += components[k].RunCount;
+		components[k].RunCount = 0;
+	}
+
+	std::vector<const meLabelRun*> componentRuns(parents.size());
+	for (size_t s = 0; s < strips_.size(); s++)
+	{
+		for (size_t i = 0; i < strips_[s].Runs.size(); i++)
+		{
+			LabelComponent& component = components[runComponents[runOffsets[s] + i]];
+			componentRuns[component.RunBegin + component.RunCount++] = &strips_[s].Runs[i];
+		}
+	}
+
+	std::vector<cv::Rect> newRects;
+	cv::Point halfPoint(mDownSamplingSize_Half, mDownSamplingSize_Half);
+
+	//Ʈ Ŀ  ڽ ̹  ڽ 𿡵   ù ĭ(õ) ã´.  INT_MAX
+	auto findNextSeed = [&](LabelComponent* component) -> int
+	{
+		auto& component_ = *component;
+		for (; component_.CursorRun < component_.RunCount; component_.CursorRun++, component_.CursorCol = 0)
+		{
+			const meLabelRun& run = *componentRuns[component_.RunBegin + component_.CursorRun];
+			if (run.Seed < 0) continue;
+
+			int bitIndex = run.Row * flagCols + std::max(component_.CursorCol, run.Seed);
+			for (int c = std::max(component_.CursorCol, run.Seed); c <= run.End; c++, bitIndex++)
+			{
+				if ((mLabelSkipBits[bitIndex >> 6] >> (bitIndex & 63)) & 1) continue;
+
+				cv::Point seedPoint = (cv::Point(c, run.Row) - cv::Point(1, 1)) * mDownSamplingSize + halfPoint;
+				bool isInNewRect = false;
+				for (size_t b = 0; (b < newRects.size()) && (isInNewRect == false); b++)
+				{
+					isInNewRect = newRects[b].contains(seedPoint);
+				}
+				if (isInNewRect) continue;
+
+				component_.CursorCol = c;
+				return run.Row * flagCols + c;
+			}
+		}
+		return INT_MAX;
+	};
+
+	//FloodFill  ĵ õ  䳻.   õ带    ĭ    ڽ  
+	//Ʈ  õ ̷, ƴϸ ڽ .  ڽ ģ Ʈ õ尡  ڽ  
+	std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<std::pair<int, int>>> seedQue;
+	for (int k = 0; k < (int)components.size(); k++)
+	{
+		int seed = findNextSeed(&components[k]);
+		if (seed != INT_MAX) seedQue.push(std::make_pair(seed, k));
+	}
+
+	int totalDetectedPixel = 0;
+	while (seedQue.empty() == false)
+	{
+		std::pair<int, int> top = seedQue.top();
+		seedQue.pop();
+
+		LabelComponent& component = components[top.second];
+		int seed = findNextSeed(&component);
+		if (seed != top.first)
+		{
+			if (seed != INT_MAX) seedQue.push(std::make_pair(seed, top.second));
+			continue;
+		}
+
+		totalDetectedPixel += component.CellCount;
+
+		//ڽ ǥ   ڸ MakeBoxWithFloodFill 
+		cv::Point pt_UpLeft = (component.UpLeft - cv::Point(2, 2)) * mDownSamplingSize + halfPoint;
+		cv::Point pt_DownRight = component.DownRight * mDownSamplingSize + halfPoint;
+
+		if (pt_UpLeft.x < 0) pt_UpLeft.x = 0;
+		if (pt_UpLeft.y < 0) pt_UpLeft.y = 0;
+		if (pt_DownRight.x > originalBoxCols - 1) pt_DownRight.x = originalBoxCols - 1;
+		if (pt_DownRight.y > originalBoxRows - 1) pt_DownRight.y = originalBoxRows - 1;
+
+		cv::Rect newRect = cv::Rect(pt_UpLeft, pt_DownRight);
+		newRects.push_back(newRect);
+		inBoxChecker_.AddBox(newRect, InBoxChecker::ColorDetection, name);
+	}
+
+	return totalDetectedPixel * mDownSamplingSize * mDownSamplingSize;
+}
+
+//÷    ڽ   2н Ͽ ε .
+//MakeBoxWithFloodFill ڽ ǥ   õ   ޶   ʴ. ÷  ڽ ɸ ĭ
+//ڽ ü ŭ  ǳʶپ   ĭ  ʰ, ĵ ߿   ڽ ǳʶڴ.
+//Ͽ ε 󺧸  ִ ڽ  ĭ .
+//ť 湮 ǥ(0x80)   ̺ ,  ڽ  ĭ  Ʈ  ־ ÷  ٲ ʴ´.
+//threadCount 2 ̸̻ ÷     Ǯ 츶  ̰, ĥ   踦 ̾ δ.
+// Ǯ Ƿ  ۾ ȿ θ ȵȴ
+int ColorDetection::MakeBoxWithUnionFind(cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker,
+	const int& originalBoxRows, const int& originalBoxCols, const std::string& name, const int& threadCount)
+{
+	auto& boxFlagFrame_ = *boxFlagFrame;
+
+	makeLabelSkipBits(boxFlagFrame_, inBoxChecker);
+
+	int gridRows = boxFlagFrame_.rows - 2;
+	if (gridRows <= 0) return 0;
+
+	int stripCount = std::max(1, std::min(threadCount, gridRows));
+	std::vector<meLabelStrip> strips(stripCount);
+	for (int s = 0; s < stripCount; s++)
+	{
+		strips[s].RowBegin = 1 + (gridRows * s) / stripCount;
+		strips[s].RowEnd = 1 + (gridRows * (s + 1)) / stripCount;
+	}
+
+	if (stripCount == 1)
+	{
+		labelStripRuns(boxFlagFrame_, &strips[0]);
+	}
+	else
+	{
+		//Ӹ 带  ʵ   Ǯ  .  Ǯ  󺧸 Ǯ   д
+		ThreadPool* pool = mBandPool.get();
+		if (pool == nullptr)
+		{
+			if ((mLabelingPool == nullptr) || (mLabelingPool->GetThreadCount() != stripCount))
+			{
+				mLabelingPool = std::make_shared<ThreadPool>(stripCount);
+			}
+			pool = mLabelingPool.get();
+		}
+		pool->ParallelFor(stripCount, [&](int s) { labelStripRuns(boxFlagFrame_, &strips[s]); });
+	}
+
+	return addBoxesFromLabelStrips(&strips, boxFlagFrame_.cols, inBoxChecker, originalBoxRows, originalBoxCols, name);
+}
+
+//Ư  ޵  ϴ Լ. ̳ʽ ǥ ؼ ̾.
+uint8_t ColorDetection::DoMedianBlur(cv::Mat* frame, const cv::Point& pt, const int& medianBlurHalfSize)
+{
+	return getSortMedian(*frame, pt, medianBlurHalfSize, &mMedianBlurTempVector);
+};
+
+//DoMedianBlur ü. 츦 sortBuffer Ƽ Ѵ. 帶 ۸    ְ ξ
+uint8_t ColorDetection::getSortMedian(const cv::Mat& frame, const cv::Point& pt, const int& half, std::vector<uint8_t>* sortBuffer)
+{
+	auto& sortBuffer_ = *sortBuffer;
+
+	const uchar* framePtr;
+	//33x33  1089ĭ̶ uint8_tδ ģ
+	int i = 0;
+	int correct = 0;
+
+	for (int r = pt.y - half; r <= pt.y + half; r++)
+	{
+
+		for (int c = pt.x - half; c <= pt.x + half; c++)
+		{
+			if ((r >= frame.rows) || (c >= frame.cols) || (r < 0) || (c < 0))
+			{
+				sortBuffer_[i] = 0xFF;
+				i++;
+				continue;
+			}
+			framePtr = frame.ptr<uchar>(r);
+			sortBuffer_[i] = framePtr[c];
+			i++;
+			correct++;
+		}
+	}
+
+	std::sort(sortBuffer_.begin(), sortBuffer_.end());
+
+	return sortBuffer_[(correct + 1) / 2 - 1];
+}
 
 
 //÷ ؼ Ķ͸ ڵ ִ Լ
@@ -4,6 +4,7 @@
 #include <queue>
 #include <io.h>	
 #include <tuple>
+#include <memory>
 
 #include <opencv2/core.hpp>
 #include <opencv2/opencv.hpp>
@@ -12,10 +13,20 @@
 
 
 #include "InBoxChecker_Tool.hpp"
+#include "ThreadPool_Tool.hpp"
 
 
 class ColorDetection
 {
+public:
+	struct ColorDetectionResult
+	{
+		std::string Name;
+		int DetectedPixelCount;
+		std::vector<cv::Rect> Boxes;
+	};
+	enum eMedianEngine { Median_Sort = 0, Median_Histogram = 1 };
+	enum eLabelingEngine { Labeling_FloodFill = 0, Labeling_UnionFind = 1 };
 private:
 	struct meHueDetectionRange
 	{
@@ -35,15 +46,94 @@ private:
 		int mSaturationThreshold;
 
 		std::string mName;
+
+		std::vector<uint8_t> mHueSatTable; // 256x256 mapped values, index = hue * 256 + saturation
+	};
+
+	// Horizontal run of non-zero flag cells, [Start, End] inclusive.
+	// Seed is the first column not covered by an existing box, or -1
+	struct meLabelRun
+	{
+		int Row;
+		int Start;
+		int End;
+		int Seed;
+	};
+	// Runs and local union-find parents of a band of flag rows [RowBegin, RowEnd)
+	struct meLabelStrip
+	{
+		int RowBegin;
+		int RowEnd;
+		std::vector<meLabelRun> Runs;
+		std::vector<int> Parents;
+		int FirstRowRunEnd;
+		int LastRowRunBegin;
+	};
+	// Grid median state of one worker. Histogram engine: per-column histograms over the current window rows
+	// and the histogram of the current window. Sort engine: the window buffer
+	struct meMedianState
+	{
+		std::vector<uint16_t> ColumnHistograms;
+		std::vector<uint16_t> KernelHistogram;
+		int HistogramTop = 0;
+		int HistogramBottom = 0;
+		int KernelLeft = 0;
+		int KernelRight = 0;
+		std::vector<uint8_t> SortBuffer;
+		std::vector<std::pair<int, int>> RowPlan; // (column, flag column) of the grid points of one row
 	};
 
 	std::vector<meHueDetectionRange> mHueDetectionRanges;
 	float colorHueMapping(float mappingValue, const int& curSaturation, meHueDetectionRange* currHueDetectionRange);
+	void makeHueSatTable(meHueDetectionRange* currHueDetectionRange);
+	void mapHueFramesFromBGR(const cv::Mat& BGRFrame, const std::vector<int>& detectionIndices,
+		std::vector<cv::Mat>* hueMappedFrames, cv::Mat* HSVFrame);
+	void resetMedianHistograms(const cv::Mat& frame, meMedianState* state);
+	void beginMedianRow(const cv::Mat& frame, const int& centerRow, const int& half, meMedianState* state);
+	uint8_t getHistogramMedian(const cv::Mat& frame, const int& centerCol, const int& half, meMedianState* state);
+	uint8_t getSortMedian(const cv::Mat& frame, const cv::Point& pt, const int& half, std::vector<uint8_t>* sortBuffer);
+	void makeGridRowPlan(const int& row, const int& frameCols, InBoxChecker* inBoxChecker, std::vector<std::pair<int, int>>* rowPlan);
+	int mapHueRowsSparse(const cv::Mat& BGRFrame, const int& frameTop, const int& gridRowBegin, const int& gridRowEnd,
+		InBoxChecker* inBoxChecker, const uint8_t* tablePtr, cv::Mat* hueMappedFrame,
+		std::vector<uchar>* columnMasks, std::vector<std::pair<int, int>>* rowPlan);
+	void makeFlagRows(const cv::Mat& hueDetectedFrame, const int& frameTop, const int& gridRowBegin, const int& gridRowEnd,
+		cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker, meMedianState* medianState);
+	int makeBoxFromFlagFrame(cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker,
+		const int& originalBoxRows, const int& originalBoxCols, const std::string& name);
+	void makeLabelSkipBits(const cv::Mat& boxFlagFrame, InBoxChecker* inBoxChecker);
+	void labelStripRuns(const cv::Mat& boxFlagFrame, meLabelStrip* strip);
+	int addBoxesFromLabelStrips(std::vector<meLabelStrip>* strips, const int& flagCols, InBoxChecker* inBoxChecker,
+		const int& originalBoxRows, const int& originalBoxCols, const std::string& name);
 
 	int mMedianBlurSize;
 	int mDownSamplingSize;
 	int mDownSamplingSize_Half;
 	std::vector<uint8_t> mMedianBlurTempVector;
+	eMedianEngine mMedianEngine = Median_Histogram;
+	eLabelingEngine mLabelingEngine = Labeling_FloodFill; // Union-find is opt-in, its boxes can differ
+	int mLabelingThreadCount = 0;        // 0 = hardware concurrency
+	std::vector<uint64_t> mLabelSkipBits; // Flag cells covered by boxes registered before labeling, one bit per cell
+	meMedianState mMedianState;
+
+	bool mbSparseEvaluation = false;  // Only used when PushThroughImage gets no HSV frame
+	int mLastTouchedPixelCount = 0;   // Pixels color-converted by the last PushThroughImage
+	std::vector<uchar> mSparseColumnMasks; // Per grid row, columns covered by the median windows
+	std::vector<cv::Mat> mAllRangesDetectedFrames;
+
+	int mBandThreadCount = 1;                     // 1 = single-threaded PushThroughImage
+	std::shared_ptr<ThreadPool> mBandPool;
+	std::shared_ptr<ThreadPool> mLabelingPool;    // Union-find strips when there is no band pool
+	std::vector<meMedianState> mBandMedianStates; // One per band
+	std::vector<cv::Mat> mBandHueFrames;          // Hue-mapped rows of each band, halo rows included
+	std::vector<std::vector<uchar>> mBandColumnMasks; // Sparse mode column masks of each band
+
+	bool mbTiledExecution = false;
+	int mTileCacheBytes = 256 * 1024;             // Working set budget of one tile (L2 size)
+	std::vector<std::vector<std::pair<int, int>>> mGridRowPlans; // makeGridRowPlan result of every grid row
+	std::vector<meMedianState> mTileMedianStates; // One per tile row
+	std::vector<cv::Mat> mTileHueFrames;          // Hue-mapped pixels of the current tile of each tile row
+
+	bool mbDebugDisplay = false;                  // Show and save the intermediate frames of PushThroughImage
 
 	std::vector<cv::Mat> mBackgroundSamples;
 	std::vector<cv::Mat> mColorSamples;
@@ -78,14 +168,34 @@ public:
 	void ClearColorDetectionRange();
 	void SetMedianBlurSize(const eMedianBlurSizes& medianBlurSize);
 	void SetDownSamplingSize(const eDownSamplingSizes& samplingSize);
+	void SetMedianEngine(const eMedianEngine& medianEngine);
+	void SetSparseEvaluation(const bool& isSparseEvaluation);
+	void SetLabelingEngine(const eLabelingEngine& labelingEngine, const int& threadCount = 0);
+	void SetBandThreadCount(const int& threadCount);
+	int GetBandThreadCount();
+	void SetTiledExecution(const bool& isTiledExecution, const int& tileCacheBytes = 256 * 1024);
+	void SetDebugDisplay(const bool& isDebugDisplay);
+	bool IsDebugDisplay();
+	int GetLastTouchedPixelCount();
 	int PushThroughImage(const cv::Mat& testFrame, cv::Mat* HSVedFrame,
 		InBoxChecker* inBoxChecker, const int& detectionIndex = 0);
+	int PushThroughImageAllRanges(const cv::Mat& testFrame, cv::Mat* HSVedFrame,
+		InBoxChecker* inBoxChecker, std::vector<ColorDetectionResult>* results);
+	void MapHueFrame(const cv::Mat& HSVFrame, cv::Mat* hueMappedFrame, const int& detectionIndex = 0, const bool& isDirectMappingKernel = false);
+	void MapHueFrameFromBGR(const cv::Mat& BGRFrame, cv::Mat* hueMappedFrame, cv::Mat* HSVFrame = nullptr, const int& detectionIndex = 0);
+	int MapHueFrameSparse(const cv::Mat& BGRFrame, cv::Mat* hueMappedFrame, InBoxChecker* inBoxChecker, const int& detectionIndex = 0);
 
 	int MakeBoxWithMedianBlur(cv::Mat* hueDetectedFrame, cv::Mat* boxFlagFrame,
 		InBoxChecker* inBoxChecker, const std::string& name);
+	int MakeBoxWithBands(const cv::Mat& BGRFrame, cv::Mat* hueMappedFrame, cv::Mat* boxFlagFrame,
+		InBoxChecker* inBoxChecker, const int& detectionIndex = 0);
+	int MakeBoxWithTiles(const cv::Mat& BGRFrame, cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker, const int& detectionIndex = 0);
 	uint8_t DoMedianBlur(cv::Mat* frame, const cv::Point& pt, const int& medianBlurHalfSize);
+	void DoGridMedianBlur(const cv::Mat& frame, cv::Mat* gridFrame, const eMedianEngine& medianEngine);
 	int MakeBoxWithFloodFill(cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker,
 		const int& originalBoxRows, const int& originalBoxCols, const std::string& name);
+	int MakeBoxWithUnionFind(cv::Mat* boxFlagFrame, InBoxChecker* inBoxChecker,
+		const int& originalBoxRows, const int& originalBoxCols, const std::string& name, const int& threadCount = 1);
 
 	void MakeColorDetection(const std::string& colorSampleFolder, const int& hueMargin = 8);
 };
\ No newline at end of file
@@ -0,0 +1,356 @@
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+#include <opencv2/core.hpp>
+
+#include "MappedFile_Tool.hpp"
+
+class DNNOutputCache
+{
+private:
+	struct meCacheHeader
+	{
+		uint32_t mMagic;
+		uint32_t mVersion;
+		uint64_t mModelHash;
+		uint64_t mImageHash;
+		int32_t mInpWidth;
+		int32_t mInpHeight;
+		int32_t mOutputCount;
+		int32_t mReserved;
+	};
+
+	std::string mCacheFolder;
+	uint64_t mModelHash;
+	int mInpWidth;
+	int mInpHeight;
+	bool mbOpened;
+
+	MappedFile mMappedEntry; // Entry the outputs of the last hit Load point into
+
+	int mHitCount;
+	int mMissCount;
+
+	std::string getEntryPath(const uint64_t& imageHash);
+	void releaseMappedView();
+
+public:
+	DNNOutputCache();
+	~DNNOutputCache();
+
+	static uint64_t HashBytes(const void* data, const size_t& size, const uint64_t& seed);
+	static uint64_t HashFile(const std::string& path, const uint64_t& seed);
+	static uint64_t HashImage(const cv::Mat& frame);
+
+	bool Open(const std::string& cacheFolder, const std::string& modelConfiguration, const std::string& modelWeights,
+		const int& inpWidth, const int& inpHeight);
+	void Close();
+	bool IsOpened();
+	void SetInputSize(const int& inpWidth, const int& inpHeight);
+	std::string GetCacheFolder();
+
+	bool Load(const cv::Mat& frame, std::vector<cv::Mat>* outs);
+	bool Store(const cv::Mat& frame, const std::vector<cv::Mat>& outs);
+
+	int GetHitCount();
+	int GetMissCount();
+};
+
+static const uint32_t CACHE_MAGIC = 0x434E4E44; // "DNNC"
+static const uint32_t CACHE_VERSION = 1;
+static const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+//
+DNNOutputCache::DNNOutputCache()
+{
+	mModelHash = 0;
+	mInpWidth = 0;
+	mInpHeight = 0;
+	mbOpened = false;
+
+	mHitCount = 0;
+	mMissCount = 0;
+}
+
+//Ҹ, ִ  ݴ´
+DNNOutputCache::~DNNOutputCache()
+{
+	Close();
+}
+
+//FNV-1a 64Ʈ ؽ. seed  ؽð  ̾ ȴ.
+uint64_t DNNOutputCache::HashBytes(const void* data, const size_t& size, const uint64_t& seed)
+{
+	const uint8_t* bytes = (const uint8_t*)data;
+	uint64_t hash = seed;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		hash ^= bytes[i];
+		hash *= FNV_PRIME;
+	}
+
+	return hash;
+}
+
+//  ü ؽø ϴ Լ. cfg, weights Ͽ Ѵ.
+uint64_t DNNOutputCache::HashFile(const std::string& path, const uint64_t& seed)
+{
+	std::ifstream readF(path, std::ios::binary);
+	std::vector<char> buffer(1 << 20);
+	uint64_t hash = seed;
+
+	if (readF.is_open() == false)
+	{
+		std::cerr << "Can't open file for hashing : " << path << std::endl;
+		return hash;
+	}
+
+	while (readF)
+	{
+		readF.read(buffer.data(), buffer.size());
+		hash = HashBytes(buffer.data(), (size_t)readF.gcount(), hash);
+	}
+
+	return hash;
+}
+
+//̹ ũ, Ÿ, ȼ ü ؽø ϴ Լ
+uint64_t DNNOutputCache::HashImage(const cv::Mat& frame)
+{
+	int32_t shape[3] = { frame.rows, frame.cols, frame.type() };
+	uint64_t hash = HashBytes(shape, sizeof(shape), FNV_OFFSET_BASIS);
+
+	size_t rowBytes = frame.cols * frame.elemSize();
+	for (int r = 0; r < frame.rows; r++)
+	{
+		hash = HashBytes(frame.ptr(r), rowBytes, hash);
+	}
+
+	return hash;
+}
+
+//ĳ    Ѵ.  ؽô cfg + weights + Էũ .
+bool DNNOutputCache::Open(const std::string& cacheFolder, const std::string& modelConfiguration, const std::string& modelWeights,
+	const int& inpWidth, const int& inpHeight)
+{
+	Close();
+
+	//̹ ִ   
+#ifdef _WIN32
+	_mkdir(cacheFolder.c_str());
+#else
+	mkdir(cacheFolder.c_str(), 0755);
+#endif
+
+	mCacheFolder = cacheFolder;
+	mInpWidth = inpWidth;
+	mInpHeight = inpHeight;
+
+	mModelHash = HashFile(modelConfiguration, FNV_OFFSET_BASIS);
+	mModelHash = HashFile(modelWeights, mModelHash);
+
+	mHitCount = 0;
+	mMissCount = 0;
+	mbOpened = true;
+
+	return true;
+}
+
+//ĳø ݴ´. ε °  ִ Mat ִٸ    Ѵ.
+void DNNOutputCache::Close()
+{
+	releaseMappedView();
+	mbOpened = false;
+}
+
+bool DNNOutputCache::IsOpened()
+{
+	return mbOpened;
+}
+
+//Ʈũ Է ũ⸸ ٲ۴.  ؽô ״  Ʈ ũ⺰  ȴ
+void DNNOutputCache::SetInputSize(const int& inpWidth, const int& inpHeight)
+{
+	releaseMappedView();
+
+	mInpWidth = inpWidth;
+	mInpHeight = inpHeight;
+}
+
+std::string DNNOutputCache::GetCacheFolder()
+{
+	return mCacheFolder;
+}
+
+//ĳ Ʈ  .  ؽ, Էũ, ̹ ؽ÷ ̸ ´.
+std::string DNNOutputCache::getEntryPath(const uint64_t& imageHash)
+{
+	char fileName[64];
+	snprintf(fileName, sizeof(fileName), "%016llx_%dx%d_%016llx.bin",
+		(unsigned long long)mModelHash, mInpWidth, mInpHeight, (unsigned long long)imageHash);
+
+	return mCacheFolder + "/" + fileName;
+}
+
+// ص  Ѵ
+void DNNOutputCache::releaseMappedView()
+{
+	mMappedEntry.Close();
+}
+
+//̹ ´ ĳ Ʈ ޸ ؼ outs δ.   ʴ´.
+//outs  Load Close  ȿϰ, б ̴.
+//  /Էũ/̹  ʰų  ߷ Ʈ  false ȯѴ.
+bool DNNOutputCache::Load(const cv::Mat& frame, std::vector<cv::Mat>* outs)
+{
+	auto& outs_ = *outs;
+
+	//outs   並 Ű   Ƿ   . з   ޸𸮸 Ű ʴ´
+	outs_.clear();
+	releaseMappedView();
+
+	if (mbOpened == false)
+	{
+		return false;
+	}
+
+	uint64_t imageHash = HashImage(frame);
+	std::string path = getEntryPath(imageHash);
+
+	//  ϰ  MappedFile Ѵ.   ׳ ̰̽,   
+	if (mMappedEntry.Open(path) == false)
+	{
+		std::remove(path.c_str());
+		mMissCount++;
+		return false;
+	}
+
+	bool isValid = (mMappedEntry.GetSize() >= sizeof(meCacheHeader));
+
+	if (isValid)
+	{
+		const uint8_t* bytes = (const uint8_t*)mMappedEntry.GetData();
+		const meCacheHeader* header = (const meCacheHeader*)bytes;
+
+		isValid = (header->mMagic == CACHE_MAGIC) && (header->mVersion == CACHE_VERSION)
+			&& (header->mModelHash == mModelHash) && (header->mImageHash == imageHash)
+			&& (header->mInpWidth == mInpWidth) && (header->mInpHeight == mInpHeight)
+			&& (header->mOutputCount > 0);
+
+		size_t offset = sizeof(meCacheHeader);
+		size_t totalSize = mMappedEntry.GetSize();
+
+		if (isValid)
+		{
+			outs_.resize(header->mOutputCount);
+		}
+
+		for (int i = 0; isValid && (i < header->mOutputCount); i++)
+		{
+			if (offset + 2 * sizeof(int32_t) > totalSize)
+			{
+				isValid = false;
+				break;
+			}
+
+			const int32_t* dims = (const int32_t*)(bytes + offset);
+			offset += 2 * sizeof(int32_t);
+
+			size_t dataSize = (size_t)dims[0] * dims[1] * sizeof(float);
+			if ((dims[0] <= 0) || (dims[1] <= 0) || (offset + dataSize > totalSize))
+			{
+				isValid = false;
+				break;
+			}
+
+			outs_[i] = cv::Mat(dims[0], dims[1], CV_32F, (void*)(bytes + offset));
+			offset += dataSize;
+		}
+	}
+
+	if (isValid == false)
+	{
+		// ʴ Ʈ ڵ ȿȭ
+		outs_.clear();
+		releaseMappedView();
+		std::remove(path.c_str());
+		mMissCount++;
+		return false;
+	}
+
+	mHitCount++;
+	return true;
+}
+
+//Ʈũ ° ̹ ´ ĳ Ʈ Ѵ
+bool DNNOutputCache::Store(const cv::Mat& frame, const std::vector<cv::Mat>& outs)
+{
+	if (mbOpened == false)
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < outs.size(); i++)
+	{
+		if ((outs[i].dims != 2) || (outs[i].type() != CV_32F))
+		{
+			return false;
+		}
+	}
+
+	meCacheHeader header = meCacheHeader();
+	header.mMagic = CACHE_MAGIC;
+	header.mVersion = CACHE_VERSION;
+	header.mModelHash = mModelHash;
+	header.mImageHash = HashImage(frame);
+	header.mInpWidth = mInpWidth;
+	header.mInpHeight = mInpHeight;
+	header.mOutputCount = (int32_t)outs.size();
+	header.mReserved = 0;
+
+	std::string path = getEntryPath(header.mImageHash);
+	std::ofstream writeF(path, std::ios::binary | std::ios::trunc);
+	if (writeF.is_open() == false)
+	{
+		std::cerr << "Can't write dnn output cache : " << path << std::endl;
+		return false;
+	}
+
+	writeF.write((const char*)&header, sizeof(header));
+
+	for (size_t i = 0; i < outs.size(); i++)
+	{
+		int32_t dims[2] = { outs[i].rows, outs[i].cols };
+		writeF.write((const char*)dims, sizeof(dims));
+
+		size_t rowBytes = outs[i].cols * sizeof(float);
+		for (int r = 0; r < outs[i].rows; r++)
+		{
+			writeF.write((const char*)outs[i].ptr<float>(r), rowBytes);
+		}
+	}
+
+	writeF.close();
+	return true;
+}
+
+int DNNOutputCache::GetHitCount()
+{
+	return mHitCount;
+}
+
+int DNNOutputCache::GetMissCount()
+{
+	return mMissCount;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <fstream>
+#include <iostream>
+
+#include <opencv2/core.hpp>
+
+#include "MappedFile_Tool.hpp"
+
+class DNNOutputCache
+{
+private:
+	struct meCacheHeader
+	{
+		uint32_t mMagic;
+		uint32_t mVersion;
+		uint64_t mModelHash;
+		uint64_t mImageHash;
+		int32_t mInpWidth;
+		int32_t mInpHeight;
+		int32_t mOutputCount;
+		int32_t mReserved;
+	};
+
+	std::string mCacheFolder;
+	uint64_t mModelHash;
+	int mInpWidth;
+	int mInpHeight;
+	bool mbOpened;
+
+	MappedFile mMappedEntry; // Entry the outputs of the last hit Load point into
+
+	int mHitCount;
+	int mMissCount;
+
+	std::string getEntryPath(const uint64_t& imageHash);
+	void releaseMappedView();
+
+public:
+	DNNOutputCache();
+	~DNNOutputCache();
+
+	static uint64_t HashBytes(const void* data, const size_t& size, const uint64_t& seed);
+	static uint64_t HashFile(const std::string& path, const uint64_t& seed);
+	static uint64_t HashImage(const cv::Mat& frame);
+
+	bool Open(const std::string& cacheFolder, const std::string& modelConfiguration, const std::string& modelWeights,
+		const int& inpWidth, const int& inpHeight);
+	void Close();
+	bool IsOpened();
+	void SetInputSize(const int& inpWidth, const int& inpHeight);
+	std::string GetCacheFolder();
+
+	bool Load(const cv::Mat& frame, std::vector<cv::Mat>* outs);
+	bool Store(const cv::Mat& frame, const std::vector<cv::Mat>& outs);
+
+	int GetHitCount();
+	int GetMissCount();
+};
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include <vector>
+#include <string>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "InBoxChecker_Tool.hpp"
+
+class FrameChangeGate
+{
+public:
+	struct CachedResults
+	{
+		std::vector<InBoxChecker::BoxInfo> Boxes;
+		int DetectedPixels;
+		float GrayScale;
+	};
+private:
+	cv::Size mSignatureSize;
+	float mChangeThreshold;
+
+	cv::Mat mGrayFrame;
+	cv::Mat mSignature;
+	cv::Mat mLastSignature;
+	cv::Mat mDiff;
+
+	CachedResults mCachedResults;
+	bool mbHasCachedResults;
+
+	int mSkippedFrameCount;
+	int mProcessedFrameCount;
+
+	void makeSignature(const cv::Mat& currFrame, cv::Mat* signature);
+
+public:
+	FrameChangeGate(const cv::Size& signatureSize = cv::Size(32, 24), const float& changeThreshold = 3.0f);
+
+	bool IsChanged(const cv::Mat& currFrame);
+	void StoreResults(InBoxChecker* inBoxChecker, const int& detectedPixels, const float& grayScale);
+	bool RestoreResults(InBoxChecker* inBoxChecker, int* detectedPixels, float* grayScale);
+	void Reset();
+
+	bool SetChangeThreshold(const float& changeThreshold);
+	int GetSkippedFrameCount();
+	int GetProcessedFrameCount();
+};
+
+//. signatureSize  ٿ  ũ, changeThreshold   (0~255) 
+FrameChangeGate::FrameChangeGate(const cv::Size& signatureSize, const float& changeThreshold)
+{
+	mSignatureSize = signatureSize;
+	mChangeThreshold = changeThreshold;
+
+	mCachedResults.DetectedPixels = 0;
+	mCachedResults.GrayScale = 0.0f;
+	mbHasCachedResults = false;
+
+	mSkippedFrameCount = 0;
+	mProcessedFrameCount = 0;
+}
+
+// ȸ ٲٰ  ũ ٿ 񱳿 ñ״ó 
+void FrameChangeGate::makeSignature(const cv::Mat& currFrame, cv::Mat* signature)
+{
+	if (currFrame.channels() == 3)
+	{
+		cv::cvtColor(currFrame, mGrayFrame, cv::COLOR_BGR2GRAY);
+		cv::resize(mGrayFrame, *signature, mSignatureSize, 0, 0, cv::INTER_AREA);
+	}
+	else
+	{
+		cv::resize(currFrame, *signature, mSignatureSize, 0, 0, cv::INTER_AREA);
+	}
+}
+
+//   Ӱ ؼ ٲ true. ̶   StoreResults  ־ Ѵ.
+//false  ǳʶٰ RestoreResults   .
+//ٷ   ƴ϶  ó Ӱ ϹǷ ݾ ٲ 鵵 ̸ ٽ óȴ.
+bool FrameChangeGate::IsChanged(const cv::Mat& currFrame)
+{
+	makeSignature(currFrame, &mSignature);
+
+	bool isChanged = true;
+	if (mbHasCachedResults && (mLastSignature.size() == mSignature.size()))
+	{
+		cv::absdiff(mSignature, mLastSignature, mDiff);
+		isChanged = (cv::mean(mDiff)[0] > mChangeThreshold);
+	}
+
+	if (isChanged)
+	{
+		mSignature.copyTo(mLastSignature);
+		mProcessedFrameCount++;
+	}
+	else
+	{
+		mSkippedFrameCount++;
+	}
+
+	return isChanged;
+}
+
+//   Ѵ. ιڽüĿ ڽ(, ÷ ؼ)  ȼ , ׷̽ 
+void FrameChangeGate::StoreResults(InBoxChecker* inBoxChecker, const int& detectedPixels, const float& grayScale)
+{
+	InBoxChecker& inBoxChecker_ = *inBoxChecker;
+
+	mCachedResults.Boxes.clear();
+	for (int i = 0; i < inBoxChecker_.GetBoxCount(); i++)
+	{
+		mCachedResults.Boxes.push_back(inBoxChecker_.GetBox(i));
+	}
+	mCachedResults.DetectedPixels = detectedPixels;
+	mCachedResults.GrayScale = grayScale;
+	mbHasCachedResults = true;
+}
+
+//  ιڽüĿ 鿡 ٽ ִ´.    false
+bool FrameChangeGate::RestoreResults(InBoxChecker* inBoxChecker, int* detectedPixels, float* grayScale)
+{
+	InBoxChecker& inBoxChecker_ = *inBoxChecker;
+
+	if (mbHasCachedResults == false)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < mCachedResults.Boxes.size(); i++)
+	{
+		inBoxChecker_.AddBox(mCachedResults.Boxes[i].Box, mCachedResults.Boxes[i].Type, mCachedResults.Boxes[i].Name);
+	}
+	*detectedPixels = mCachedResults.DetectedPixels;
+	*grayScale = mCachedResults.GrayScale;
+
+	return true;
+}
+
+//  ī͸ .    óȴ
+void FrameChangeGate::Reset()
+{
+	mLastSignature.release();
+	mCachedResults.Boxes.clear();
+	mbHasCachedResults = false;
+	mSkippedFrameCount = 0;
+	mProcessedFrameCount = 0;
+}
+
+bool FrameChangeGate::SetChangeThreshold(const float& changeThreshold)
+{
+	if ((0.0f <= changeThreshold) && (changeThreshold <= 255.0f))
+	{
+		mChangeThreshold = changeThreshold;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+//ǳʶ  
+int FrameChangeGate::GetSkippedFrameCount()
+{
+	return mSkippedFrameCount;
+}
+
+//   
+int FrameChangeGate::GetProcessedFrameCount()
+{
+	return mProcessedFrameCount;
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "InBoxChecker_Tool.hpp"
+
+class FrameChangeGate
+{
+public:
+	struct CachedResults
+	{
+		std::vector<InBoxChecker::BoxInfo> Boxes;
+		int DetectedPixels;
+		float GrayScale;
+	};
+private:
+	cv::Size mSignatureSize;
+	float mChangeThreshold;
+
+	cv::Mat mGrayFrame;
+	cv::Mat mSignature;
+	cv::Mat mLastSignature;
+	cv::Mat mDiff;
+
+	CachedResults mCachedResults;
+	bool mbHasCachedResults;
+
+	int mSkippedFrameCount;
+	int mProcessedFrameCount;
+
+	void makeSignature(const cv::Mat& currFrame, cv::Mat* signature);
+
+public:
+	FrameChangeGate(const cv::Size& signatureSize = cv::Size(32, 24), const float& changeThreshold = 3.0f);
+
+	bool IsChanged(const cv::Mat& currFrame);
+	void StoreResults(InBoxChecker* inBoxChecker, const int& detectedPixels, const float& grayScale);
+	bool RestoreResults(InBoxChecker* inBoxChecker, int* detectedPixels, float* grayScale);
+	void Reset();
+
+	bool SetChangeThreshold(const float& changeThreshold);
+	int GetSkippedFrameCount();
+	int GetProcessedFrameCount();
+};
\ No newline at end of file
@@ -0,0 +1,255 @@
+#include <vector>
+#include <string>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+
+#include "YOLO_v3_Module.hpp"
+#include "ColorDetection_Module.hpp"
+
+class LatencyGovernor
+{
+public:
+	enum eStage { Stage_YOLO = 0, Stage_ColorDetection = 1, Stage_GrayScale = 2, Stage_Count = 3 };
+	struct QualityLevel
+	{
+		int InpSize;
+		ColorDetection::eMedianBlurSizes MedianBlurSize;
+		ColorDetection::eDownSamplingSizes DownSamplingSize;
+	};
+private:
+	std::vector<QualityLevel> mLevels;
+	int mCurrentLevel;
+
+	double mTargetFrameTime;    // ms
+	double mRaiseRatio;         // raise quality only when the frame time is below target * ratio
+	int mWindowSize;            // frames averaged before each decision
+
+	std::chrono::high_resolution_clock::time_point mStageStartTimes[Stage_Count];
+	double mStageTimeSums[Stage_Count];
+	double mLastStageTimes[Stage_Count];
+	int mWindowFrameCount;
+	int mFrameCount;
+	int mSwitchCount;
+
+	std::string mLogFileAddress;
+
+	std::string levelToString(const int& level);
+	void writeLog(const std::string& message);
+
+public:
+	LatencyGovernor(const double& targetFrameTime, const int& startLevel = 2, const std::string& logFileAddress = "G_LatencyGovernor_Log.txt");
+
+	void SetLevels(const std::vector<QualityLevel>& levels);
+	bool SetLevel(const int& level, YOLO_v3_DNN* YOLOv3_Module, ColorDetection* colorDetection_Module);
+	void ApplyLevel(YOLO_v3_DNN* YOLOv3_Module, ColorDetection* colorDetection_Module);
+	bool SetTargetFrameTime(const double& targetFrameTime);
+	bool SetWindowSize(const int& windowSize);
+
+	void BeginStage(const eStage& stage);
+	void EndStage(const eStage& stage);
+	bool EndFrame(YOLO_v3_DNN* YOLOv3_Module, ColorDetection* colorDetection_Module);
+
+	int GetCurrentLevel();
+	double GetStageTime(const eStage& stage);
+	int GetSwitchCount();
+};
+
+//. ⺻ ܰ   320/416/608 Է°   ÷ ؼ ̴.
+//startLevel 2 ݱ  608, F9x9, S11x11 ̴.
+LatencyGovernor::LatencyGovernor(const double& targetFrameTime, const int& startLevel, const std::string& logFileAddress)
+{
+	mLevels.clear();
+	mLevels.push_back({ 320, ColorDetection::F5x5, ColorDetection::S15x15 });
+	mLevels.push_back({ 416, ColorDetection::F7x7, ColorDetection::S13x13 });
+	mLevels.push_back({ 608, ColorDetection::F9x9, ColorDetection::S11x11 });
+	mLevels.push_back({ 608, ColorDetection::F11x11, ColorDetection::S9x9 });
+
+	mCurrentLevel = std::max(0, std::min(startLevel, (int)mLevels.size() - 1));
+
+	mTargetFrameTime = targetFrameTime;
+	mRaiseRatio = 0.7;
+	mWindowSize = 10;
+
+	for (int i = 0; i < Stage_Count; i++)
+	{
+		mStageTimeSums[i] = 0.0;
+		mLastStageTimes[i] = 0.0;
+	}
+	mWindowFrameCount = 0;
+	mFrameCount = 0;
+	mSwitchCount = 0;
+
+	mLogFileAddress = logFileAddress;
+}
+
+//ܰ  ٲ۴.  ܰ  ܰ  ִ´
+void LatencyGovernor::SetLevels(const std::vector<QualityLevel>& levels)
+{
+	if (levels.empty())
+	{
+		return;
+	}
+
+	mLevels = levels;
+	mCurrentLevel = std::min(mCurrentLevel, (int)mLevels.size() - 1);
+}
+
+//ܰ踦  ϰ 鿡 Ѵ
+bool LatencyGovernor::SetLevel(const int& level, YOLO_v3_DNN* YOLOv3_Module, ColorDetection* colorDetection_Module)
+{
+	if ((level < 0) || (level >= (int)mLevels.size()))
+	{
+		return false;
+	}
+
+	if (level != mCurrentLevel)
+	{
+		writeLog("frame " + std::to_string(mFrameCount) + " : level " + levelToString(mCurrentLevel) + " -> " + levelToString(level) + " (manual)");
+		mCurrentLevel = level;
+		mSwitchCount++;
+	}
+
+	ApplyLevel(YOLOv3_Module, colorDetection_Module);
+	return true;
+}
+
+// ܰ  鿡 ִ´. Ҷ ѹ ҷش
+void LatencyGovernor::ApplyLevel(YOLO_v3_DNN* YOLOv3_Module, ColorDetection* colorDetection_Module)
+{
+	const QualityLevel& level = mLevels[mCurrentLevel];
+
+	YOLOv3_Module->SetInputSize(level.InpSize, level.InpSize);
+	colorDetection_Module->SetMedianBlurSize(level.MedianBlurSize);
+	colorDetection_Module->SetDownSamplingSize(level.DownSamplingSize);
+}
+
+//ǥ  ð(ms)
+bool LatencyGovernor::SetTargetFrameTime(const double& targetFrameTime)
+{
+	if (targetFrameTime > 0.0)
+	{
+		mTargetFrameTime = targetFrameTime;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+//   ܰ踦 ٲ Ѵ
+bool LatencyGovernor::SetWindowSize(const int& windowSize)
+{
+	if (windowSize >= 1)
+	{
+		mWindowSize = windowSize;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+// ϳ ð  
+void LatencyGovernor::BeginStage(const eStage& stage)
+{
+	mStageStartTimes[stage] = std::chrono::high_resolution_clock::now();
+}
+
+// ϳ ð  
+void LatencyGovernor::EndStage(const eStage& stage)
+{
+	auto endTime = std::chrono::high_resolution_clock::now();
+	mStageTimeSums[stage] += std::chrono::duration<double, std::milli>(endTime - mStageStartTimes[stage]).count();
+}
+
+// ϳ  θ. mWindowSize Ӹ   ð  ܰ踦 ٲٰ, ٲ true
+//ǥ   ܰ , ǥ mRaiseRatio躸   ܰ ø.  ̴ ״ ּ ܰ谡 Դٰ  ʰ Ѵ.
+bool LatencyGovernor::EndFrame(YOLO_v3_DNN* YOLOv3_Module, ColorDetection* colorDetection_Module)
+{
+	mFrameCount++;
+	mWindowFrameCount++;
+	if (mWindowFrameCount < mWindowSize)
+	{
+		return false;
+	}
+
+	double frameTime = 0.0;
+	for (int i = 0; i < Stage_Count; i++)
+	{
+		mLastStageTimes[i] = mStageTimeSums[i] / mWindowFrameCount;
+		frameTime += mLastStageTimes[i];
+		mStageTimeSums[i] = 0.0;
+	}
+	mWindowFrameCount = 0;
+
+	int newLevel = mCurrentLevel;
+	std::string reason;
+	if ((frameTime > mTargetFrameTime) && (mCurrentLevel > 0))
+	{
+		newLevel = mCurrentLevel - 1;
+		reason = " > target ";
+	}
+	else if ((frameTime < mTargetFrameTime * mRaiseRatio) && (mCurrentLevel < (int)mLevels.size() - 1))
+	{
+		newLevel = mCurrentLevel + 1;
+		reason = " < headroom ";
+	}
+
+	if (newLevel == mCurrentLevel)
+	{
+		return false;
+	}
+
+	std::stringstream message;
+	message << "frame " << mFrameCount << " : level " << levelToString(mCurrentLevel) << " -> " << levelToString(newLevel)
+		<< ", mean frame " << frameTime << "ms" << reason << mTargetFrameTime << "ms"
+		<< " [YOLO " << mLastStageTimes[Stage_YOLO] << " / Color " << mLastStageTimes[Stage_ColorDetection]
+		<< " / Gray " << mLastStageTimes[Stage_GrayScale] << "]";
+	writeLog(message.str());
+
+	mCurrentLevel = newLevel;
+	mSwitchCount++;
+	ApplyLevel(YOLOv3_Module, colorDetection_Module);
+
+	return true;
+}
+
+int LatencyGovernor::GetCurrentLevel()
+{
+	return mCurrentLevel;
+}
+
+// Ǵ   ϳ Ӵ  ð(ms)
+double LatencyGovernor::GetStageTime(const eStage& stage)
+{
+	return mLastStageTimes[stage];
+}
+
+int LatencyGovernor::GetSwitchCount()
+{
+	return mSwitchCount;
+}
+
+//α׿ ܰ 
+std::string LatencyGovernor::levelToString(const int& level)
+{
+	const QualityLevel& level_ = mLevels[level];
+	return std::to_string(level) + "(" + std::to_string(level_.InpSize) + " F" + std::to_string((int)level_.MedianBlurSize)
+		+ " S" + std::to_string((int)level_.DownSamplingSize) + ")";
+}
+
+//ܰ谡 ٲ𶧸 ְܼ α Ͽ 
+void LatencyGovernor::writeLog(const std::string& message)
+{
+	std::cout << "[LatencyGovernor] " << message << std::endl;
+
+	std::ofstream writeT;
+	writeT.open(mLogFileAddress, std::ios::app);
+	writeT << message << "\n";
+	writeT.close();
+}
\ No newline at end of file
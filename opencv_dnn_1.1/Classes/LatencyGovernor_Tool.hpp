@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+
+#include "YOLO_v3_Module.hpp"
+#include "ColorDetection_Module.hpp"
+
+
+class LatencyGovernor
+{
+public:
+	enum eStage { Stage_YOLO = 0, Stage_ColorDetection = 1, Stage_GrayScale = 2, Stage_Count = 3 };
+	struct QualityLevel
+	{
+		int InpSize;
+		ColorDetection::eMedianBlurSizes MedianBlurSize;
+		ColorDetection::eDownSamplingSizes DownSamplingSize;
+	};
+private:
+	std::vector<QualityLevel> mLevels;
+	int mCurrentLevel;
+
+	double mTargetFrameTime;    // ms
+	double mRaiseRatio;         // raise quality only when the frame time is below target * ratio
+	int mWindowSize;            // frames averaged before each decision
+
+	std::chrono::high_resolution_clock::time_point mStageStartTimes[Stage_Count];
+	double mStageTimeSums[Stage_Count];
+	double mLastStageTimes[Stage_Count];
+	int mWindowFrameCount;
+	int mFrameCount;
+	int mSwitchCount;
+
+	std::string mLogFileAddress;
+
+	std::string levelToString(const int& level);
+	void writeLog(const std::string& message);
+
+public:
+	LatencyGovernor(const double& targetFrameTime, const int& startLevel = 2, const std::string& logFileAddress = "G_LatencyGovernor_Log.txt");
+
+	void SetLevels(const std::vector<QualityLevel>& levels);
+	bool SetLevel(const int& level, YOLO_v3_DNN* YOLOv3_Module, ColorDetection* colorDetection_Module);
+	void ApplyLevel(YOLO_v3_DNN* YOLOv3_Module, ColorDetection* colorDetection_Module);
+	bool SetTargetFrameTime(const double& targetFrameTime);
+	bool SetWindowSize(const int& windowSize);
+
+	void BeginStage(const eStage& stage);
+	void EndStage(const eStage& stage);
+	bool EndFrame(YOLO_v3_DNN* YOLOv3_Module, ColorDetection* colorDetection_Module);
+
+	int GetCurrentLevel();
+	double GetStageTime(const eStage& stage);
+	int GetSwitchCount();
+};
\ No newline at end of file
@@ -0,0 +1,150 @@
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <string>
+
+//-------------------------------------------------------------
+// Read-only memory mapping of a whole file. Pages are loaded by the OS on first touch and
+// shared with the file cache, so large model files are not copied through a read buffer.
+class MappedFile
+{
+private:
+	const char* mData = nullptr;
+	size_t mSize = 0;
+	void* mFileHandle = nullptr;    // HANDLE on Windows, unused elsewhere
+	void* mMappingHandle = nullptr; // HANDLE on Windows, unused elsewhere
+
+public:
+	MappedFile();
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const std::string& path);
+	void Close();
+	bool IsOpen();
+	const char* GetData();
+	size_t GetSize();
+};
+
+MappedFile::MappedFile()
+{
+}
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+// ü б  Ѵ.  ̳   false
+bool MappedFile::Open(const std::string& path)
+{
+	Close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if ((GetFileSizeEx(file, &fileSize) == FALSE) || (fileSize.QuadPart == 0))
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == NULL)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	mFileHandle = file;
+	mMappingHandle = mapping;
+	mData = (const char*)data;
+	mSize = (size_t)fileSize.QuadPart;
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat;
+	if ((fstat(file, &fileStat) != 0) || (fileStat.st_size == 0))
+	{
+		close(file);
+		return false;
+	}
+
+	void* data = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+
+	//ó  ѹ а Ƿ ̸ б⸦ ûѴ
+	madvise(data, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+
+	mData = (const char*)data;
+	mSize = (size_t)fileStat.st_size;
+#endif
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (mData == nullptr)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(mData);
+	CloseHandle((HANDLE)mMappingHandle);
+	CloseHandle((HANDLE)mFileHandle);
+#else
+	munmap((void*)mData, mSize);
+#endif
+
+	mData = nullptr;
+	mSize = 0;
+	mFileHandle = nullptr;
+	mMappingHandle = nullptr;
+}
+
+bool MappedFile::IsOpen()
+{
+	return mData != nullptr;
+}
+
+const char* MappedFile::GetData()
+{
+	return mData;
+}
+
+size_t MappedFile::GetSize()
+{
+	return mSize;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <string>
+
+//-------------------------------------------------------------
+// Read-only memory mapping of a whole file. Pages are loaded by the OS on first touch and
+// shared with the file cache, so large model files are not copied through a read buffer.
+class MappedFile
+{
+private:
+	const char* mData = nullptr;
+	size_t mSize = 0;
+	void* mFileHandle = nullptr;    // HANDLE on Windows, unused elsewhere
+	void* mMappingHandle = nullptr; // HANDLE on Windows, unused elsewhere
+
+public:
+	MappedFile();
+	~MappedFile();
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool Open(const std::string& path);
+	void Close();
+	bool IsOpen();
+	const char* GetData();
+	size_t GetSize();
+};
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <atomic>
 
 #include <opencv2/core.hpp>
 #include <opencv2/opencv.hpp>
@@ -13,6 +14,7 @@
 
 #include "InBoxChecker_Tool.hpp"
 #include "YOLO_v3_Module.hpp"
+#include "YOLOPool_Tool.hpp"
 #include "ColorDetection_Module.hpp"
 #include "GrayScale_Module.hpp"
 
@@ -103,6 +105,28 @@ public:
 	void SaveAnswer_AreaRatio_txt(const std::string& folder);
 	void SaveColorDetection_DetectionBox_txt(ColorDetection* ColorDetection_Module,
 		const int& hueMargin, const int& medianFilterSize, const int& downSamplingSize);
+
+	void CompareYoloBatchExperiment(YOLO_v3_DNN* YOLOv3_Module, const int& batchSize);
+	void DoYoloPostProcessBenchmark(YOLO_v3_DNN* YOLOv3_Module, const float& confidenceThreshold, const int& repeatCount);
+	void DoYoloNMSBenchmark(YOLO_v3_DNN* YOLOv3_Module, const int& repeatCount);
+	void DoYoloPreprocessBenchmark(YOLO_v3_DNN* YOLOv3_Module, const int& repeatCount);
+	void DoYoloLayerProfileExperiment(YOLO_v3_DNN* YOLOv3_Module, const int& repeatCount);
+	void CompareYoloTiledExperiment(YOLO_v3_DNN* YOLOv3_Module, const int& tileOverlap);
+	void CompareYoloOutputHeadsExperiment(YOLO_v3_DNN* YOLOv3_Module);
+	void CompareYoloQuantizedExperiment(YOLO_v3_DNN* YOLOv3_Module, YOLO_v3_DNN* quantizedYOLOv3_Module,
+		const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights, const int& calibrationCount);
+	void CompareYoloTrackingExperiment(YOLO_v3_DNN* YOLOv3_Module, const int& trackingInterval, const int& sequenceLength);
+	void CompareYoloPoolExperiment(YOLO_v3_Pool* YOLOv3_Pool);
+	void DoColorHueMappingBenchmark(ColorDetection* ColorDetection_Module, const int& colorRangeNum, const int& repeatCount);
+	void DoColorConversionBenchmark(ColorDetection* ColorDetection_Module, const int& colorRangeNum, const int& repeatCount);
+	void DoColorMedianBenchmark(ColorDetection* ColorDetection_Module, const int& colorRangeNum, const int& repeatCount);
+	void CompareColorSparseExperiment(YOLO_v3_DNN* YOLOv3_Module, ColorDetection* ColorDetection_Module, const int& colorRangeNum);
+	void CompareColorLabelingExperiment(ColorDetection* ColorDetection_Module, const int& colorRangeNum,
+		const int& threadCount = 4, const int& upScale = 4);
+	void DoColorBandScalingExperiment(ColorDetection* ColorDetection_Module, const int& colorRangeNum,
+		const int& maxThreadCount, const int& upScale = 4, const int& repeatCount = 5);
+	void DoColorTileBenchmark(ColorDetection* ColorDetection_Module, const int& colorRangeNum,
+		const int& upScale = 4, const int& repeatCount = 5);
 };
 
 //  ϴ Լ
@@ -136,6 +160,8 @@ void RobustOptimalExperiment::DoYoloExperiment(YOLO_v3_DNN* YOLOv3_Module,
 
 	InBoxChecker InboxChecker_Tool;
 
+	YOLOv3_Module_.ClearOutputCache();
+
 	//Ƚ  9
 	for (int y = 0; y < 9; y++)
 	{
@@ -157,7 +183,8 @@ void RobustOptimalExperiment::DoYoloExperiment(YOLO_v3_DNN* YOLOv3_Module,
 			testImg = cv::imread(TestImageFileAdds[i]);
 
 			auto startTime = std::chrono::high_resolution_clock::now();
-			YOLOv3_Module_.PassThrough(&testImg);
+			// ̹ ù ࿡ forwardϰ,  ࿡  ° ó ٽ Ѵ
+			YOLOv3_Module_.PassThrough(&testImg, TestImageFileAdds[i]);
 			YOLOv3_Module_.GetObjectRects(&InboxChecker_Tool);
 			auto endTime = std::chrono::high_resolution_clock::now();
 			std::cout << std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() << std::endl;
@@ -191,6 +218,8 @@ void RobustOptimalExperiment::DoYoloExperiment(YOLO_v3_DNN* YOLOv3_Module,
 		std::cout << std::to_string(y) << " : SN ratio = " << std::to_string(SN_temp) << std::endl;
 	}
 
+	YOLOv3_Module_.ClearOutputCache();
+
 	//ؽƮ Ϸ 
 	std::ofstream writeT;
 	writeT.open("G_YOLO_Results.txt");
@@ -227,7 +256,6 @@ void RobustOptimalExperiment::DoColorDetection_Experiment(
 	std::string variableNames[3] = { "C = Hue margin","D = MedianFilter Size","E = Downsampling Size" };
 	float SN_Ratio_Results[27];
 	for (int i = 0; i < 27; i++) SN_Ratio_Results[i] = 0.0f;
-	cv::Mat HSVedFrame;
 
 	int curHueMargin = 0;
 	int curMedianFiterSize = 0;
@@ -316,7 +344,7 @@ void RobustOptimalExperiment::DoColorDetection_Experiment(
 			ColorDetection_Module_.SetMedianBlurSize(medianFiltersize_enum);
 
 			auto startTime = std::chrono::high_resolution_clock::now();
-			int detectedPixels = ColorDetection_Module_.PushThroughImage(testImg, &HSVedFrame, &InboxChecker_Tool, colorRangeNum);
+			int detectedPixels = ColorDetection_Module_.PushThroughImage(testImg, nullptr, &InboxChecker_Tool, colorRangeNum);
 			auto endTime = std::chrono::high_resolution_clock::now();
 
 			float DetectedPixelRatio = (float)detectedPixels / (testImg.cols * testImg.rows);
@@ -1205,10 +1233,9 @@ void RobustOptimalExperiment::SaveColorDetection_DetectionBox_txt(ColorDetection
 
 		//÷ؼǿ ų ̹ ҷ
 		cv::Mat testimg = cv::imread(testImageFileAdds[i]);
-		cv::Mat HSVedFrame;
 
 		//ش ÷ Ų ,  
-		colorDetection_Module_.PushThroughImage(testimg, &HSVedFrame, &inboxChecker_Tool, color_range_num);
+		colorDetection_Module_.PushThroughImage(testimg, nullptr, &inboxChecker_Tool, color_range_num);
 
 		// ιڽ üĿ ÷ ؼ  иؿ
 		std::vector<InBoxChecker::BoxInfo> boxes = inboxChecker_Tool.GetBoxes(InBoxChecker::ColorDetection);
@@ -1232,4 +1259,1454 @@ void RobustOptimalExperiment::SaveColorDetection_DetectionBox_txt(ColorDetection
 		std::cout << boxes.size() << " boxes saved (" << i + 1 << "/" << count << ")" << "\n";
 	}
 
+}
+//  ġ   徿   ϴ Լ
+//  ڽ ٸ ̹    ҿð Ѵ.
+void RobustOptimalExperiment::CompareYoloBatchExperiment(YOLO_v3_DNN* YOLOv3_Module, const int& batchSize)
+{
+	auto& YOLOv3_Module_ = *YOLOv3_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	InBoxChecker InboxChecker_Tool;
+
+	int count = TestImageFileAdds.size();
+	std::vector<cv::Mat> testImgs;
+	for (int i = 0; i < count; i++)
+	{
+		testImgs.push_back(cv::imread(TestImageFileAdds[i]));
+	}
+
+	//徿 
+	std::vector<std::vector<cv::Rect>> singleResults;
+	auto startTime = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < count; i++)
+	{
+		InboxChecker_Tool.ClearBox();
+		YOLOv3_Module_.PassThrough(&testImgs[i]);
+		YOLOv3_Module_.GetObjectRects(&InboxChecker_Tool);
+
+		std::vector<cv::Rect> detections;
+		std::vector<InBoxChecker::BoxInfo> tempInfos = InboxChecker_Tool.GetBoxes(InBoxChecker::YOLOv3);
+		for (int j = 0; j < tempInfos.size(); j++)
+		{
+			detections.push_back(tempInfos[j].Box);
+		}
+		singleResults.push_back(detections);
+	}
+	auto endTime = std::chrono::high_resolution_clock::now();
+	auto singleElapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+	//ġ 
+	std::vector<YOLO_v3_DNN::DetectionResult> batchDetections;
+	YOLOv3_Module_.SetBatchSize(batchSize);
+	startTime = std::chrono::high_resolution_clock::now();
+	YOLOv3_Module_.PassThroughBatch(testImgs, &batchDetections);
+	endTime = std::chrono::high_resolution_clock::now();
+	auto batchElapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+	int mismatchCount = 0;
+	for (int i = 0; i < count; i++)
+	{
+		InboxChecker_Tool.ClearBox();
+		YOLOv3_Module_.GetObjectRects(batchDetections[i], &InboxChecker_Tool);
+
+		std::vector<InBoxChecker::BoxInfo> tempInfos = InboxChecker_Tool.GetBoxes(InBoxChecker::YOLOv3);
+		bool isSame = (tempInfos.size() == singleResults[i].size());
+		for (int j = 0; isSame && (j < tempInfos.size()); j++)
+		{
+			isSame = (tempInfos[j].Box == singleResults[i][j]);
+		}
+
+		if (isSame == false)
+		{
+			mismatchCount++;
+			std::cout << "batch mismatch : " << TestImageFileAdds[i] << std::endl;
+		}
+	}
+
+	std::cout << "single : " << singleElapsedTime << "us / batch(" << batchSize << ") : " << batchElapsedTime
+		<< "us / mismatch : " << mismatchCount << "/" << count << std::endl;
+
+	//ؽƮ Ϸ 
+	std::ofstream writeT;
+	writeT.open("G_YOLO_Batch_Results.txt");
+	writeT << "YOLOv3 Batch Compare Results\n";
+	writeT << "Images,BatchSize,Single(us),Batch(us),Mismatch\n";
+	writeT << count << "," << batchSize << "," << singleElapsedTime << "," << batchElapsedTime << "," << mismatchCount << "\n";
+	writeT.close();
+}
+
+// ó Ŀ(minMaxLoc , objectness  Ż + SIMD ) ӵ ϴ Լ
+//׽Ʈ ̹ Ʈũ ° ѹ صΰ,  °   Ŀ repeatCount .
+void RobustOptimalExperiment::DoYoloPostProcessBenchmark(YOLO_v3_DNN* YOLOv3_Module, const float& confidenceThreshold, const int& repeatCount)
+{
+	auto& YOLOv3_Module_ = *YOLOv3_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	YOLOv3_Module_.SetConfidenceThreshold(confidenceThreshold);
+
+	//° 
+	int count = TestImageFileAdds.size();
+	std::vector<std::vector<cv::Mat>> recordedOuts;
+	std::vector<cv::Size> frameSizes;
+	for (int i = 0; i < count; i++)
+	{
+		cv::Mat testImg = cv::imread(TestImageFileAdds[i]);
+		YOLOv3_Module_.PassThrough(&testImg);
+		recordedOuts.push_back(YOLOv3_Module_.GetRawOutputs());
+		frameSizes.push_back(testImg.size());
+	}
+
+	YOLO_v3_DNN::DetectionResult minMaxLocResult;
+	YOLO_v3_DNN::DetectionResult kernelResult;
+
+	// Ŀ    Ȯ
+	int mismatchCount = 0;
+	for (int i = 0; i < count; i++)
+	{
+		YOLOv3_Module_.DecodeOutputs(recordedOuts[i], frameSizes[i], &minMaxLocResult, true);
+		YOLOv3_Module_.DecodeOutputs(recordedOuts[i], frameSizes[i], &kernelResult, false);
+
+		if ((minMaxLocResult.ClassIds != kernelResult.ClassIds) || (minMaxLocResult.Confidences != kernelResult.Confidences)
+			|| (minMaxLocResult.Boxes != kernelResult.Boxes))
+		{
+			mismatchCount++;
+			std::cout << "post process mismatch : " << TestImageFileAdds[i] << std::endl;
+		}
+	}
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	for (int rep = 0; rep < repeatCount; rep++)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			YOLOv3_Module_.DecodeOutputs(recordedOuts[i], frameSizes[i], &minMaxLocResult, true);
+		}
+	}
+	auto endTime = std::chrono::high_resolution_clock::now();
+	auto minMaxLocElapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+	startTime = std::chrono::high_resolution_clock::now();
+	for (int rep = 0; rep < repeatCount; rep++)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			YOLOv3_Module_.DecodeOutputs(recordedOuts[i], frameSizes[i], &kernelResult, false);
+		}
+	}
+	endTime = std::chrono::high_resolution_clock::now();
+	auto kernelElapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+	int frameCount = count * repeatCount;
+	double minMaxLocPerFrame = (frameCount > 0) ? (double)minMaxLocElapsedTime / frameCount : 0.0;
+	double kernelPerFrame = (frameCount > 0) ? (double)kernelElapsedTime / frameCount : 0.0;
+
+	std::cout << "minMaxLoc : " << minMaxLocPerFrame << "us/frame / kernel : " << kernelPerFrame
+		<< "us/frame / mismatch : " << mismatchCount << "/" << count << std::endl;
+
+	//ؽƮ Ϸ 
+	std::ofstream writeT;
+	writeT.open("G_YOLO_PostProcess_Benchmark.txt");
+	writeT << "YOLOv3 Post Process Benchmark Results\n";
+	writeT << "Images,Repeat,ConfidenceThreshold,MinMaxLoc(us/frame),Kernel(us/frame),Mismatch\n";
+	writeT << count << "," << repeatCount << "," << confidenceThreshold << "," << minMaxLocPerFrame << "," << kernelPerFrame << "," << mismatchCount << "\n";
+	writeT.close();
+}
+
+//cv::dnn::NMSBoxes    NMS ӵ ĺ ڽ  ϴ Լ
+//ĺ ڽ 640x480  ȿ   ġ    Ȧ Ȳ ϰ Ѵ.
+void RobustOptimalExperiment::DoYoloNMSBenchmark(YOLO_v3_DNN* YOLOv3_Module, const int& repeatCount)
+{
+	auto& YOLOv3_Module_ = *YOLOv3_Module;
+
+	const int candidateCounts[6] = { 100, 500, 1000, 2000, 5000, 10000 };
+	const int frameCols = 640;
+	const int frameRows = 480;
+
+	cv::RNG rng(0x1234);
+
+	std::ofstream writeT;
+	writeT.open("G_YOLO_NMS_Benchmark.txt");
+	writeT << "YOLOv3 NMS Benchmark Results\n";
+	writeT << "Candidates,Repeat,NMSBoxes(us),Engine(us),Kept,Mismatch\n";
+
+	for (int c = 0; c < 6; c++)
+	{
+		YOLO_v3_DNN::DetectionResult candidates;
+		int clusterCount = candidateCounts[c] / 50 + 1;
+
+		for (int i = 0; i < candidateCounts[c]; i++)
+		{
+			int cluster = i % clusterCount;
+			cv::RNG clusterRng(cluster + 1);
+			int centerX = clusterRng.uniform(0, frameCols);
+			int centerY = clusterRng.uniform(0, frameRows);
+
+			int width = rng.uniform(10, 120);
+			int height = rng.uniform(10, 120);
+			int left = centerX + rng.uniform(-15, 16) - width / 2;
+			int top = centerY + rng.uniform(-15, 16) - height / 2;
+
+			candidates.Boxes.push_back(cv::Rect(left, top, width, height));
+			candidates.Confidences.push_back(rng.uniform(0.0f, 1.0f));
+			candidates.ClassIds.push_back(0);
+		}
+
+		YOLO_v3_DNN::DetectionResult openCVResult = candidates;
+		YOLO_v3_DNN::DetectionResult engineResult = candidates;
+
+		auto startTime = std::chrono::high_resolution_clock::now();
+		for (int rep = 0; rep < repeatCount; rep++)
+		{
+			YOLOv3_Module_.RunNMS(&openCVResult, true);
+		}
+		auto endTime = std::chrono::high_resolution_clock::now();
+		auto openCVElapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+		startTime = std::chrono::high_resolution_clock::now();
+		for (int rep = 0; rep < repeatCount; rep++)
+		{
+			YOLOv3_Module_.RunNMS(&engineResult, false);
+		}
+		endTime = std::chrono::high_resolution_clock::now();
+		auto engineElapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+		bool isMismatch = (openCVResult.Indices != engineResult.Indices);
+
+		std::cout << "candidates : " << candidateCounts[c] << " / NMSBoxes : " << openCVElapsedTime << "us / engine : " << engineElapsedTime
+			<< "us / kept : " << engineResult.Indices.size() << (isMismatch ? " / MISMATCH" : "") << std::endl;
+
+		writeT << candidateCounts[c] << "," << repeatCount << "," << openCVElapsedTime << "," << engineElapsedTime << ","
+			<< engineResult.Indices.size() << "," << (isMismatch ? 1 : 0) << "\n";
+	}
+
+	writeT.close();
+}
+
+//ū ػ ӿ ° Ű Ͱ ŸϷ  Ű  ó ϴ Լ
+//׽Ʈ ̹ ī޶ ػ󵵵 Ű  ػ󵵺 Ӵ ð  ڽ  Ѵ.
+void RobustOptimalExperiment::CompareYoloTiledExperiment(YOLO_v3_DNN* YOLOv3_Module, const int& tileOverlap)
+{
+	auto& YOLOv3_Module_ = *YOLOv3_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	InBoxChecker InboxChecker_Tool;
+
+	const cv::Size resolutions[] = { cv::Size(640, 480), cv::Size(1280, 960), cv::Size(1920, 1440), cv::Size(2592, 1944) };
+	const int resolutionCount = sizeof(resolutions) / sizeof(resolutions[0]);
+
+	YOLOv3_Module_.SetTileOverlap(tileOverlap);
+
+	std::ofstream writeT;
+	writeT.open("G_YOLO_Tiled_Results.txt");
+	writeT << "YOLOv3 Tiled Compare Results\n";
+	writeT << "Width,Height,Images,Tiles,TileOverlap,Whole(us),Tiled(us),WholeFPS,TiledFPS,WholeBoxes,TiledBoxes\n";
+
+	int count = TestImageFileAdds.size();
+	cv::Mat testImg;
+	cv::Mat resizedImg;
+
+	for (int r = 0; r < resolutionCount; r++)
+	{
+		long long wholeElapsedTime = 0;
+		long long tiledElapsedTime = 0;
+		int wholeBoxCount = 0;
+		int tiledBoxCount = 0;
+
+		for (int i = 0; i < count; i++)
+		{
+			testImg = cv::imread(TestImageFileAdds[i]);
+			cv::resize(testImg, resizedImg, resolutions[r]);
+
+			//° 
+			InboxChecker_Tool.ClearBox();
+			auto startTime = std::chrono::high_resolution_clock::now();
+			YOLOv3_Module_.PassThrough(&resizedImg);
+			wholeBoxCount += YOLOv3_Module_.GetObjectRects(&InboxChecker_Tool);
+			auto endTime = std::chrono::high_resolution_clock::now();
+			wholeElapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+			//ŸϷ 
+			InboxChecker_Tool.ClearBox();
+			startTime = std::chrono::high_resolution_clock::now();
+			YOLOv3_Module_.PassThroughTiled(&resizedImg);
+			tiledBoxCount += YOLOv3_Module_.GetObjectRects(&InboxChecker_Tool);
+			endTime = std::chrono::high_resolution_clock::now();
+			tiledElapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+		}
+
+		int tileCount = YOLOv3_Module_.GetTileCount(resolutions[r]);
+		double wholeFPS = (wholeElapsedTime > 0) ? (count * 1000000.0 / wholeElapsedTime) : 0.0;
+		double tiledFPS = (tiledElapsedTime > 0) ? (count * 1000000.0 / tiledElapsedTime) : 0.0;
+
+		std::cout << resolutions[r].width << "x" << resolutions[r].height << " / tiles : " << tileCount
+			<< " / whole : " << wholeFPS << "fps, " << wholeBoxCount << " boxes / tiled : " << tiledFPS << "fps, " << tiledBoxCount << " boxes" << std::endl;
+
+		writeT << resolutions[r].width << "," << resolutions[r].height << "," << count << "," << tileCount << "," << tileOverlap << ","
+			<< wholeElapsedTime << "," << tiledElapsedTime << "," << wholeFPS << "," << tiledFPS << "," << wholeBoxCount << "," << tiledBoxCount << "\n";
+	}
+
+	writeT.close();
+}
+
+//   Ӵ ð IoUc  ϴ Լ
+void RobustOptimalExperiment::CompareYoloOutputHeadsExperiment(YOLO_v3_DNN* YOLOv3_Module)
+{
+	auto& YOLOv3_Module_ = *YOLOv3_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	InBoxChecker InboxChecker_Tool;
+
+	const int headConfigs[] = {
+		YOLO_v3_DNN::Head_All,
+		YOLO_v3_DNN::Head_Stride32 | YOLO_v3_DNN::Head_Stride16,
+		YOLO_v3_DNN::Head_Stride32,
+		YOLO_v3_DNN::Head_Stride16,
+		YOLO_v3_DNN::Head_Stride8 };
+	const std::string headConfigNames[] = { "32+16+8", "32+16", "32", "16", "8" };
+	const int configCount = sizeof(headConfigs) / sizeof(headConfigs[0]);
+
+	int count = TestImageFileAdds.size();
+	std::vector<cv::Mat> testImgs;
+	std::vector<std::vector<cv::Rect>> answers;
+	for (int i = 0; i < count; i++)
+	{
+		testImgs.push_back(cv::imread(TestImageFileAdds[i]));
+
+		std::string boxInfo_address = imageFileNames[i].substr(0, imageFileNames[i].length() - 4);
+		boxInfo_address = "./testImages_resized\\" + boxInfo_address + ".txt";
+		answers.push_back(getYOLOBoxes(boxInfo_address, testImgs[i].cols, testImgs[i].rows));
+	}
+
+	std::ofstream writeT;
+	writeT.open("G_YOLO_OutputHeads_Results.txt");
+	writeT << "YOLOv3 Output Heads Compare Results\n";
+	writeT << "Heads,Images,Total(us),PerFrame(us),MeanIoUc\n";
+
+	for (int h = 0; h < configCount; h++)
+	{
+		YOLOv3_Module_.SetOutputHeads(headConfigs[h]);
+
+		//ù forward ޸ Ҵ ̹Ƿ ѹ  
+		if (count > 0)
+		{
+			YOLOv3_Module_.PassThrough(&testImgs[0]);
+		}
+
+		long long elapsedTime = 0;
+		float IoUcSum = 0.0f;
+		for (int i = 0; i < count; i++)
+		{
+			InboxChecker_Tool.ClearBox();
+
+			auto startTime = std::chrono::high_resolution_clock::now();
+			YOLOv3_Module_.PassThrough(&testImgs[i]);
+			auto endTime = std::chrono::high_resolution_clock::now();
+			elapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+			YOLOv3_Module_.GetObjectRects(&InboxChecker_Tool);
+			std::vector<InBoxChecker::BoxInfo> tempInfos = InboxChecker_Tool.GetBoxes(InBoxChecker::YOLOv3);
+			std::vector<cv::Rect> detections;
+			for (int j = 0; j < tempInfos.size(); j++)
+			{
+				detections.push_back(tempInfos[j].Box);
+			}
+
+			IoUcSum += compare_YOLO_IoUc(answers[i], detections, testImgs[i].cols, testImgs[i].rows);
+		}
+
+		long long perFrameTime = (count > 0) ? (elapsedTime / count) : 0;
+		float meanIoUc = (count > 0) ? (IoUcSum / count) : 0.0f;
+
+		std::cout << "heads " << headConfigNames[h] << " : " << perFrameTime << "us per frame / mean IoUc = " << meanIoUc << std::endl;
+
+		writeT << headConfigNames[h] << "," << count << "," << elapsedTime << "," << perFrameTime << "," << meanIoUc << "\n";
+	}
+
+	YOLOv3_Module_.SetOutputHeads(YOLO_v3_DNN::Head_All);
+
+	writeT.close();
+}
+
+//float 𵨰 INT8 ȭ  ӵ, ޸, IoUc  ϴ Լ
+//YOLOv3_Module float 𵨷  ¿ ϰ, quantizedYOLOv3_Module  Ϸ ⼭ ȭؼ .
+//Ķ극̼ ̹ ׽Ʈ ̹ ߿ calibrationCount  ̴´.
+void RobustOptimalExperiment::CompareYoloQuantizedExperiment(YOLO_v3_DNN* YOLOv3_Module, YOLO_v3_DNN* quantizedYOLOv3_Module,
+	const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights, const int& calibrationCount)
+{
+	auto& YOLOv3_Module_ = *YOLOv3_Module;
+	auto& quantizedYOLOv3_Module_ = *quantizedYOLOv3_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	InBoxChecker InboxChecker_Tool;
+
+	int count = TestImageFileAdds.size();
+	std::vector<cv::Mat> testImgs;
+	std::vector<std::vector<cv::Rect>> answers;
+	for (int i = 0; i < count; i++)
+	{
+		testImgs.push_back(cv::imread(TestImageFileAdds[i]));
+
+		std::string boxInfo_address = imageFileNames[i].substr(0, imageFileNames[i].length() - 4);
+		boxInfo_address = "./testImages_resized\\" + boxInfo_address + ".txt";
+		answers.push_back(getYOLOBoxes(boxInfo_address, testImgs[i].cols, testImgs[i].rows));
+	}
+
+	//Ķ극̼ ̹   ȭ
+	std::vector<cv::Mat> calibrationFrames;
+	int calibrationCount_ = std::min(calibrationCount, count);
+	for (int i = 0; i < calibrationCount_; i++)
+	{
+		calibrationFrames.push_back(testImgs[i * count / calibrationCount_]);
+	}
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	bool isQuantized = quantizedYOLOv3_Module_.MakeQuantizedYOLONetFromFile(classesFile, modelConfiguration, modelWeights, calibrationFrames);
+	auto endTime = std::chrono::high_resolution_clock::now();
+	auto calibrationTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+
+	//ȭ ȵ float ϰ ǹǷ  ʴ´
+	if (isQuantized == false)
+	{
+		std::cout << "quantization failed, skip the FP32 vs INT8 compare" << std::endl;
+		return;
+	}
+
+	YOLO_v3_DNN* modules[2] = { &YOLOv3_Module_, &quantizedYOLOv3_Module_ };
+	const std::string moduleNames[2] = { "FP32", "INT8" };
+
+	std::ofstream writeT;
+	writeT.open("G_YOLO_Quantized_Results.txt");
+	writeT << "YOLOv3 Quantized Compare Results\n";
+	writeT << "CalibrationImages," << calibrationCount_ << ",CalibrationTime(ms)," << calibrationTime << "\n";
+	writeT << "Model,Images,PerFrame(us),Weights(byte),Blobs(byte),MeanIoUc\n";
+
+	for (int m = 0; m < 2; m++)
+	{
+		auto& module_ = *modules[m];
+
+		size_t weightsBytes = 0;
+		size_t blobsBytes = 0;
+		module_.GetMemoryConsumption(&weightsBytes, &blobsBytes);
+
+		//ù forward ޸ Ҵ ̹Ƿ ѹ  
+		if (count > 0)
+		{
+			module_.PassThrough(&testImgs[0]);
+		}
+
+		long long elapsedTime = 0;
+		float IoUcSum = 0.0f;
+		for (int i = 0; i < count; i++)
+		{
+			InboxChecker_Tool.ClearBox();
+
+			startTime = std::chrono::high_resolution_clock::now();
+			module_.PassThrough(&testImgs[i]);
+			endTime = std::chrono::high_resolution_clock::now();
+			elapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+			module_.GetObjectRects(&InboxChecker_Tool);
+			std::vector<InBoxChecker::BoxInfo> tempInfos = InboxChecker_Tool.GetBoxes(InBoxChecker::YOLOv3);
+			std::vector<cv::Rect> detections;
+			for (int j = 0; j < tempInfos.size(); j++)
+			{
+				detections.push_back(tempInfos[j].Box);
+			}
+
+			IoUcSum += compare_YOLO_IoUc(answers[i], detections, testImgs[i].cols, testImgs[i].rows);
+		}
+
+		long long perFrameTime = (count > 0) ? (elapsedTime / count) : 0;
+		float meanIoUc = (count > 0) ? (IoUcSum / count) : 0.0f;
+
+		std::cout << moduleNames[m] << " : " << perFrameTime << "us per frame / weights " << weightsBytes << " byte / blobs " << blobsBytes
+			<< " byte / mean IoUc = " << meanIoUc << std::endl;
+
+		writeT << moduleNames[m] << "," << count << "," << perFrameTime << "," << weightsBytes << "," << blobsBytes << "," << meanIoUc << "\n";
+	}
+
+	writeT.close();
+}
+
+//⺻ Mat Ҵڸ μ   Mat   . ġ     Mat(OpenCV Լ  ӽ Mat ) .
+//cv::AutoBufferó fastMalloc ٷ  ӽ ۴ Mat Ҵڸ ġ Ƿ  ʴ´
+class CountingMatAllocator : public cv::MatAllocator
+{
+private:
+	const cv::MatAllocator* mBaseAllocator;
+	mutable std::atomic<int> mAllocCount;
+public:
+	CountingMatAllocator(const cv::MatAllocator* baseAllocator) : mBaseAllocator(baseAllocator), mAllocCount(0) {}
+
+	cv::UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step, cv::AccessFlag flags, cv::UMatUsageFlags usageFlags) const override
+	{
+		//data  ܺ ۿ  ̴ ̶ Ҵ ƴϴ
+		if (data == NULL)
+		{
+			mAllocCount++;
+		}
+		return mBaseAllocator->allocate(dims, sizes, type, data, step, flags, usageFlags);
+	}
+
+	bool allocate(cv::UMatData* data, cv::AccessFlag accessFlags, cv::UMatUsageFlags usageFlags) const override
+	{
+		return mBaseAllocator->allocate(data, accessFlags, usageFlags);
+	}
+
+	void deallocate(cv::UMatData* data) const override
+	{
+		mBaseAllocator->deallocate(data);
+	}
+
+	int GetAllocCount() const
+	{
+		return mAllocCount;
+	}
+};
+
+//blobFromImage   ó ӵ  ̸ ϴ Լ.
+//ù     CountingMatAllocator  ä  Ӹ   Mat    
+void RobustOptimalExperiment::DoYoloPreprocessBenchmark(YOLO_v3_DNN* YOLOv3_Module, const int& repeatCount)
+{
+	auto& YOLOv3_Module_ = *YOLOv3_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	int count = TestImageFileAdds.size();
+	std::vector<cv::Mat> testImgs;
+	for (int i = 0; i < count; i++)
+	{
+		testImgs.push_back(cv::imread(TestImageFileAdds[i]));
+	}
+
+	if (count == 0)
+	{
+		return;
+	}
+
+	cv::Mat referenceBlob;
+	cv::Mat reusedBlob;
+
+	//ù ӿ ۸ Ƶΰ  Ŀ ۰ ٽ  Ƚ 
+	YOLOv3_Module_.PreprocessFrame(testImgs[0], &reusedBlob);
+	int warmUpReallocCount = YOLOv3_Module_.GetPreprocessReallocCount();
+
+	// blobFromImage  Ȯ
+	double maxDifference = 0.0;
+	for (int i = 0; i < count; i++)
+	{
+		cv::Size inputSize(reusedBlob.size[3], reusedBlob.size[2]);
+		referenceBlob = cv::dnn::blobFromImage(testImgs[i], 1 / 255.0, inputSize, cv::Scalar(0, 0, 0), true, false);
+		YOLOv3_Module_.PreprocessFrame(testImgs[i], &reusedBlob);
+
+		double difference = cv::norm(referenceBlob, reusedBlob, cv::NORM_INF);
+		maxDifference = std::max(maxDifference, difference);
+	}
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	for (int rep = 0; rep < repeatCount; rep++)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			cv::Size inputSize(reusedBlob.size[3], reusedBlob.size[2]);
+			referenceBlob = cv::dnn::blobFromImage(testImgs[i], 1 / 255.0, inputSize, cv::Scalar(0, 0, 0), true, false);
+		}
+	}
+	auto endTime = std::chrono::high_resolution_clock::now();
+	auto blobFromImageElapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+	startTime = std::chrono::high_resolution_clock::now();
+	for (int rep = 0; rep < repeatCount; rep++)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			YOLOv3_Module_.PreprocessFrame(testImgs[i], &reusedBlob);
+		}
+	}
+	endTime = std::chrono::high_resolution_clock::now();
+	auto reusedElapsedTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+	int steadyReallocCount = YOLOv3_Module_.GetPreprocessReallocCount() - warmUpReallocCount;
+
+	//Ÿְ̹    Mat Ҵڸ ٲ  ä 
+	cv::MatAllocator* defaultAllocator = cv::Mat::getDefaultAllocator();
+	CountingMatAllocator countingAllocator(defaultAllocator);
+	cv::Mat::setDefaultAllocator(&countingAllocator);
+	for (int i = 0; i < count; i++)
+	{
+		YOLOv3_Module_.PreprocessFrame(testImgs[i], &reusedBlob);
+	}
+	cv::Mat::setDefaultAllocator(defaultAllocator);
+	double matAllocsPerFrame = (double)countingAllocator.GetAllocCount() / count;
+
+	std::cout << "blobFromImage : " << blobFromImageElapsedTime << "us / reused blob : " << reusedElapsedTime << "us / max diff : " << maxDifference
+		<< " / steady state buffer reallocations : " << steadyReallocCount << " / Mat allocations per frame : " << matAllocsPerFrame << std::endl;
+
+	//ؽƮ Ϸ 
+	std::ofstream writeT;
+	writeT.open("G_YOLO_Preprocess_Benchmark.txt");
+	writeT << "YOLOv3 Preprocess Benchmark Results\n";
+	writeT << "Images,Repeat,blobFromImage(us),ReusedBlob(us),MaxDiff,WarmUpReallocations,SteadyReallocations,MatAllocationsPerFrame\n";
+	writeT << count << "," << repeatCount << "," << blobFromImageElapsedTime << "," << reusedElapsedTime << "," << maxDifference << ","
+		<< warmUpReallocCount << "," << steadyReallocCount << "," << matAllocsPerFrame << "\n";
+	writeT.close();
+}
+
+//    θ ϴ Լ
+//׽Ʈ ̹ ݾ ̵Ų sequenceLength   ,   ڽ    ڽ 󸶳  .
+//drift 1 - (   ڽ   ġ  ڽ IoU )̴.
+void RobustOptimalExperiment::CompareYoloTrackingExperiment(YOLO_v3_DNN* YOLOv3_Module, const int& trackingInterval, const int& sequenceLength)
+{
+	auto& YOLOv3_Module_ = *YOLOv3_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	InBoxChecker InboxChecker_Tool;
+
+	YOLOv3_Module_.SetTrackingInterval(trackingInterval);
+
+	int count = TestImageFileAdds.size();
+	cv::Mat testImg;
+	cv::Mat shiftedImg;
+
+	long long trackedElapsedTime = 0;
+	long long fullElapsedTime = 0;
+	double IoUSum = 0.0;
+	int IoUCount = 0;
+	int detectedFrameCount = 0;
+	int frameCount = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		testImg = cv::imread(TestImageFileAdds[i]);
+		YOLOv3_Module_.ResetTracking();
+
+		for (int f = 0; f < sequenceLength; f++)
+		{
+			//ī޶ õõ ̴ ó Ӹ 2, 1 ȼ ű
+			cv::Mat shift = (cv::Mat_<double>(2, 3) << 1, 0, 2 * f, 0, 1, f);
+			cv::warpAffine(testImg, shiftedImg, shift, testImg.size(), cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+
+			// 
+			InboxChecker_Tool.ClearBox();
+			auto startTime = std::chrono::high_resolution_clock::now();
+			YOLOv3_Module_.PassThroughTracked(&shiftedImg);
+			YOLOv3_Module_.GetObjectRects(&InboxChecker_Tool);
+			auto endTime = std::chrono::high_resolution_clock::now();
+			trackedElapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+			if (YOLOv3_Module_.IsLastFrameDetected()) detectedFrameCount++;
+
+			std::vector<InBoxChecker::BoxInfo> trackedInfos = InboxChecker_Tool.GetBoxes(InBoxChecker::YOLOv3);
+
+			//  
+			InboxChecker_Tool.ClearBox();
+			startTime = std::chrono::high_resolution_clock::now();
+			YOLOv3_Module_.PassThrough(&shiftedImg);
+			YOLOv3_Module_.GetObjectRects(&InboxChecker_Tool);
+			endTime = std::chrono::high_resolution_clock::now();
+			fullElapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+			std::vector<InBoxChecker::BoxInfo> fullInfos = InboxChecker_Tool.GetBoxes(InBoxChecker::YOLOv3);
+
+			for (int a = 0; a < fullInfos.size(); a++)
+			{
+				float bestIoU = 0.0f;
+				for (int b = 0; b < trackedInfos.size(); b++)
+				{
+					float inter = (float)(fullInfos[a].Box & trackedInfos[b].Box).area();
+					float uni = (float)(fullInfos[a].Box.area() + trackedInfos[b].Box.area()) - inter;
+					if (uni > 0.0f) bestIoU = std::max(bestIoU, inter / uni);
+				}
+				IoUSum += bestIoU;
+				IoUCount++;
+			}
+
+			frameCount++;
+		}
+	}
+
+	float dutyCycle = (frameCount > 0) ? ((float)detectedFrameCount / frameCount) : 0.0f;
+	float drift = (IoUCount > 0) ? (float)(1.0 - IoUSum / IoUCount) : 0.0f;
+	long long trackedPerFrame = (frameCount > 0) ? (trackedElapsedTime / frameCount) : 0;
+	long long fullPerFrame = (frameCount > 0) ? (fullElapsedTime / frameCount) : 0;
+
+	std::cout << "interval " << trackingInterval << " / duty cycle : " << dutyCycle << " / tracked : " << trackedPerFrame
+		<< "us per frame / full rate : " << fullPerFrame << "us per frame / drift : " << drift << std::endl;
+
+	//ؽƮ Ϸ 
+	std::ofstream writeT;
+	writeT.open("G_YOLO_Tracking_Results.txt");
+	writeT << "YOLOv3 Tracking Compare Results\n";
+	writeT << "Interval,Frames,DutyCycle,Tracked(us/frame),FullRate(us/frame),Drift\n";
+	writeT << trackingInterval << "," << frameCount << "," << dutyCycle << "," << trackedPerFrame << "," << fullPerFrame << "," << drift << "\n";
+	writeT.close();
+}
+
+
+//Ǯ  ŭ 带 Ἥ ׽Ʈ ̹ ü ÿ óϰ 徿 ó Ͱ ӵ,  Ѵ
+void RobustOptimalExperiment::CompareYoloPoolExperiment(YOLO_v3_Pool* YOLOv3_Pool)
+{
+	auto& YOLOv3_Pool_ = *YOLOv3_Pool;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	int count = TestImageFileAdds.size();
+	std::vector<cv::Mat> testImgs(count);
+	for (int i = 0; i < count; i++)
+	{
+		testImgs[i] = cv::imread(TestImageFileAdds[i]);
+	}
+
+	//徿 ó
+	std::vector<YOLO_v3_DNN::DetectionResult> serialDetections(count);
+	auto startTime = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < count; i++)
+	{
+		YOLOv3_Pool_.PassThrough(testImgs[i], &serialDetections[i]);
+	}
+	auto endTime = std::chrono::high_resolution_clock::now();
+	long long serialElapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+
+	// ŭ ÿ ó
+	std::vector<YOLO_v3_DNN::DetectionResult> poolDetections;
+	startTime = std::chrono::high_resolution_clock::now();
+	YOLOv3_Pool_.PassThroughAll(testImgs, &poolDetections);
+	endTime = std::chrono::high_resolution_clock::now();
+	long long poolElapsedTime = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+
+	// ġ  ƾ Ѵ
+	int mismatchCount = 0;
+	for (int i = 0; i < count; i++)
+	{
+		if ((serialDetections[i].Indices != poolDetections[i].Indices) || (serialDetections[i].Boxes != poolDetections[i].Boxes))
+		{
+			mismatchCount++;
+		}
+	}
+
+	float speedUp = (poolElapsedTime > 0) ? ((float)serialElapsedTime / poolElapsedTime) : 0.0f;
+
+	std::cout << "replicas " << YOLOv3_Pool_.GetReplicaCount() << " / serial : " << serialElapsedTime << "ms / pool : " << poolElapsedTime
+		<< "ms / speed up : " << speedUp << " / mismatch : " << mismatchCount << std::endl;
+
+	//ؽƮ Ϸ 
+	std::ofstream writeT;
+	writeT.open("G_YOLO_Pool_Results.txt");
+	writeT << "YOLOv3 Pool Compare Results\n";
+	writeT << "Replicas,Images,Serial(ms),Pool(ms),SpeedUp,Mismatch\n";
+	writeT << YOLOv3_Pool_.GetReplicaCount() << "," << count << "," << serialElapsedTime << "," << poolElapsedTime << "," << speedUp << "," << mismatchCount << "\n";
+	writeT.close();
+}
+
+//׽Ʈ ̹ repeatCount  ̾ ð 踦 CSV, JSON ϰ   ɸ ̾ ش
+void RobustOptimalExperiment::DoYoloLayerProfileExperiment(YOLO_v3_DNN* YOLOv3_Module, const int& repeatCount)
+{
+	auto& YOLOv3_Module_ = *YOLOv3_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	int count = TestImageFileAdds.size();
+	std::vector<cv::Mat> testImgs(count);
+	for (int i = 0; i < count; i++)
+	{
+		testImgs[i] = cv::imread(TestImageFileAdds[i]);
+	}
+
+	YOLOv3_Module_.StartLayerProfiling(std::max(1, count * repeatCount));
+	for (int r = 0; r < repeatCount; r++)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			YOLOv3_Module_.PassThrough(&testImgs[i]);
+		}
+	}
+	YOLOv3_Module_.StopLayerProfiling();
+
+	YOLOv3_Module_.SaveInferenceProfileCSV("G_YOLO_LayerProfile.csv");
+	YOLOv3_Module_.SaveInferenceProfileJSON("G_YOLO_LayerProfile.json");
+
+	// ð   10
+	YOLO_v3_DNN::InferenceProfile profile = YOLOv3_Module_.GetInferenceProfile();
+	std::vector<YOLO_v3_DNN::LayerProfile> layers = profile.Layers;
+	std::sort(layers.begin(), layers.end(), [](const YOLO_v3_DNN::LayerProfile& a, const YOLO_v3_DNN::LayerProfile& b)
+	{
+		return a.MeanTime > b.MeanTime;
+	});
+
+	std::cout << "frames " << profile.FrameCount << " / forward min : " << profile.MinTotal << "ms / mean : " << profile.MeanTotal
+		<< "ms / p95 : " << profile.P95Total << "ms" << std::endl;
+	for (size_t i = 0; (i < layers.size()) && (i < 10); i++)
+	{
+		std::cout << layers[i].Name << " (" << layers[i].Type << ") mean : " << layers[i].MeanTime << "ms / p95 : " << layers[i].P95Time
+			<< "ms / " << ((profile.MeanTotal > 0.0) ? (layers[i].MeanTime * 100.0 / profile.MeanTotal) : 0.0) << "%" << std::endl;
+	}
+}
+
+//hue  ̺ Ŀΰ ȼ ϴ Ŀη   ӵ ϰ  Ʈ   ȮѴ.
+//׽Ʈ ̹ ܿ  (hue, saturation) 256x256    ̹ε Ѵ
+void RobustOptimalExperiment::DoColorHueMappingBenchmark(ColorDetection* ColorDetection_Module, const int& colorRangeNum, const int& repeatCount)
+{
+	auto& ColorDetection_Module_ = *ColorDetection_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	// (hue, saturation) .  hue,  saturation
+	cv::Mat allPairsFrame(256, 256, CV_8UC3);
+	for (int h = 0; h < 256; h++)
+	{
+		cv::Vec3b* allPairsPtr = allPairsFrame.ptr<cv::Vec3b>(h);
+		for (int s = 0; s < 256; s++)
+		{
+			allPairsPtr[s] = cv::Vec3b((uchar)h, (uchar)s, 255);
+		}
+	}
+
+	cv::Mat directFrame;
+	cv::Mat tableFrame;
+	ColorDetection_Module_.MapHueFrame(allPairsFrame, &directFrame, colorRangeNum, true);
+	ColorDetection_Module_.MapHueFrame(allPairsFrame, &tableFrame, colorRangeNum, false);
+	int allPairsMismatch = cv::countNonZero(directFrame != tableFrame);
+
+	int count = TestImageFileAdds.size();
+	cv::Mat testImg;
+	cv::Mat HSVFrame;
+
+	long long directElapsedTime = 0;
+	long long tableElapsedTime = 0;
+	int imageMismatch = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		testImg = cv::imread(TestImageFileAdds[i]);
+		cv::cvtColor(testImg, HSVFrame, cv::COLOR_BGR2HSV);
+
+		auto startTime = std::chrono::high_resolution_clock::now();
+		for (int r = 0; r < repeatCount; r++)
+		{
+			ColorDetection_Module_.MapHueFrame(HSVFrame, &directFrame, colorRangeNum, true);
+		}
+		auto endTime = std::chrono::high_resolution_clock::now();
+		directElapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+		startTime = std::chrono::high_resolution_clock::now();
+		for (int r = 0; r < repeatCount; r++)
+		{
+			ColorDetection_Module_.MapHueFrame(HSVFrame, &tableFrame, colorRangeNum, false);
+		}
+		endTime = std::chrono::high_resolution_clock::now();
+		tableElapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+		imageMismatch += cv::countNonZero(directFrame != tableFrame);
+	}
+
+	int mapCount = std::max(1, count * repeatCount);
+	float speedUp = (tableElapsedTime > 0) ? ((float)directElapsedTime / tableElapsedTime) : 0.0f;
+
+	std::cout << "hue mapping / direct : " << directElapsedTime / mapCount << "us / table : " << tableElapsedTime / mapCount
+		<< "us / speed up : " << speedUp << " / mismatch (all pairs) : " << allPairsMismatch << " / mismatch (images) : " << imageMismatch << std::endl;
+
+	//ؽƮ Ϸ 
+	std::ofstream writeT;
+	writeT.open("G_ColorHueMapping_Benchmark.txt");
+	writeT << "Color Hue Mapping Benchmark\n";
+	writeT << "Images,Repeat,Direct(us/frame),Table(us/frame),SpeedUp,MismatchAllPairs,MismatchImages\n";
+	writeT << count << "," << repeatCount << "," << directElapsedTime / mapCount << "," << tableElapsedTime / mapCount << ","
+		<< speedUp << "," << allPairsMismatch << "," << imageMismatch << "\n";
+	writeT.close();
+}
+
+//cvtColor HSV    ̺ ϴ  ܰ İ BGR ٷ ϴ  ӵ ϰ,
+//  HSV  cvtColor Ȱ ȮѴ
+void RobustOptimalExperiment::DoColorConversionBenchmark(ColorDetection* ColorDetection_Module, const int& colorRangeNum, const int& repeatCount)
+{
+	auto& ColorDetection_Module_ = *ColorDetection_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	int count = TestImageFileAdds.size();
+	cv::Mat testImg;
+	cv::Mat HSVFrame;
+	cv::Mat fusedHSVFrame;
+	cv::Mat twoPassFrame;
+	cv::Mat fusedFrame;
+
+	long long twoPassElapsedTime = 0;
+	long long fusedElapsedTime = 0;
+	int mappingMismatch = 0;
+	int HSVMismatch = 0;
+
+	for (int i = 0; i < count; i++)
+	{
+		testImg = cv::imread(TestImageFileAdds[i]);
+
+		auto startTime = std::chrono::high_resolution_clock::now();
+		for (int r = 0; r < repeatCount; r++)
+		{
+			cv::cvtColor(testImg, HSVFrame, cv::COLOR_BGR2HSV);
+			ColorDetection_Module_.MapHueFrame(HSVFrame, &twoPassFrame, colorRangeNum);
+		}
+		auto endTime = std::chrono::high_resolution_clock::now();
+		twoPassElapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+		startTime = std::chrono::high_resolution_clock::now();
+		for (int r = 0; r < repeatCount; r++)
+		{
+			ColorDetection_Module_.MapHueFrameFromBGR(testImg, &fusedFrame, nullptr, colorRangeNum);
+		}
+		endTime = std::chrono::high_resolution_clock::now();
+		fusedElapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+		mappingMismatch += cv::countNonZero(twoPassFrame != fusedFrame);
+
+		//HSV  ޶  HSV  
+		ColorDetection_Module_.MapHueFrameFromBGR(testImg, &fusedFrame, &fusedHSVFrame, colorRangeNum);
+		HSVMismatch += cv::countNonZero((HSVFrame != fusedHSVFrame).reshape(1));
+	}
+
+	int mapCount = std::max(1, count * repeatCount);
+	float speedUp = (fusedElapsedTime > 0) ? ((float)twoPassElapsedTime / fusedElapsedTime) : 0.0f;
+
+	std::cout << "color conversion / cvtColor + mapping : " << twoPassElapsedTime / mapCount << "us / fused : " << fusedElapsedTime / mapCount
+		<< "us / speed up : " << speedUp << " / mismatch (mapping) : " << mappingMismatch << " / mismatch (HSV) : " << HSVMismatch << std::endl;
+
+	//ؽƮ Ϸ 
+	std::ofstream writeT;
+	writeT.open("G_ColorConversion_Benchmark.txt");
+	writeT << "Color Conversion Benchmark\n";
+	writeT << "Images,Repeat,TwoPass(us/frame),Fused(us/frame),SpeedUp,MismatchMapping,MismatchHSV\n";
+	writeT << count << "," << repeatCount << "," << twoPassElapsedTime / mapCount << "," << fusedElapsedTime / mapCount << ","
+		<< speedUp << "," << mappingMismatch << "," << HSVMismatch << "\n";
+	writeT.close();
+}
+
+//F3x3 F33x33 ׸ ޵  İ ׷   ؼ ӵ ϰ   ȮѴ.
+// ޵  ũ F33x33 Ƿ ٽ ؼ  Ѵ
+void RobustOptimalExperiment::DoColorMedianBenchmark(ColorDetection* ColorDetection_Module, const int& colorRangeNum, const int& repeatCount)
+{
+	auto& ColorDetection_Module_ = *ColorDetection_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	//׽Ʈ ̹ ̸ hue صд
+	int count = TestImageFileAdds.size();
+	std::vector<cv::Mat> hueMappedFrames(count);
+	for (int i = 0; i < count; i++)
+	{
+		cv::Mat testImg = cv::imread(TestImageFileAdds[i]);
+		ColorDetection_Module_.MapHueFrameFromBGR(testImg, &hueMappedFrames[i], nullptr, colorRangeNum);
+	}
+
+	const ColorDetection::eMedianBlurSizes medianSizes[] = {
+		ColorDetection::F3x3, ColorDetection::F5x5, ColorDetection::F7x7, ColorDetection::F9x9,
+		ColorDetection::F11x11, ColorDetection::F13x13, ColorDetection::F15x15, ColorDetection::F17x17,
+		ColorDetection::F19x19, ColorDetection::F21x21, ColorDetection::F23x23, ColorDetection::F25x25,
+		ColorDetection::F27x27, ColorDetection::F29x29, ColorDetection::F31x31, ColorDetection::F33x33 };
+
+	//ؽƮ Ϸ 
+	std::ofstream writeT;
+	writeT.open("G_ColorMedian_Benchmark.txt");
+	writeT << "Color Grid Median Benchmark\n";
+	writeT << "MedianSize,Sort(us/frame),Histogram(us/frame),SpeedUp,Mismatch\n";
+
+	cv::Mat sortGrid;
+	cv::Mat histogramGrid;
+	int mapCount = std::max(1, count * repeatCount);
+
+	for (int m = 0; m < 16; m++)
+	{
+		ColorDetection_Module_.SetMedianBlurSize(medianSizes[m]);
+
+		long long sortElapsedTime = 0;
+		long long histogramElapsedTime = 0;
+		int mismatchCount = 0;
+
+		for (int i = 0; i < count; i++)
+		{
+			auto startTime = std::chrono::high_resolution_clock::now();
+			for (int r = 0; r < repeatCount; r++)
+			{
+				ColorDetection_Module_.DoGridMedianBlur(hueMappedFrames[i], &sortGrid, ColorDetection::Median_Sort);
+			}
+			auto endTime = std::chrono::high_resolution_clock::now();
+			sortElapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+			startTime = std::chrono::high_resolution_clock::now();
+			for (int r = 0; r < repeatCount; r++)
+			{
+				ColorDetection_Module_.DoGridMedianBlur(hueMappedFrames[i], &histogramGrid, ColorDetection::Median_Histogram);
+			}
+			endTime = std::chrono::high_resolution_clock::now();
+			histogramElapsedTime += std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+			mismatchCount += cv::countNonZero(sortGrid != histogramGrid);
+		}
+
+		float speedUp = (histogramElapsedTime > 0) ? ((float)sortElapsedTime / histogramElapsedTime) : 0.0f;
+
+		std::cout << "F" << medianSizes[m] << "x" << medianSizes[m] << " / sort : " << sortElapsedTime / mapCount << "us / histogram : "
+			<< histogramElapsedTime / mapCount << "us / speed up : " << speedUp << " / mismatch : " << mismatchCount << std::endl;
+		writeT << medianSizes[m] << "," << sortElapsedTime / mapCount << "," << histogramElapsedTime / mapCount << ","
+			<< speedUp << "," << mismatchCount << "\n";
+	}
+
+	writeT.close();
+}
+
+// ڽ   ְ ü ȯ  ȯ  ÷ ؼ ڽ 
+//ȯ ȼ , ð, ( ȼ , ڽ) Ѵ
+void RobustOptimalExperiment::CompareColorSparseExperiment(YOLO_v3_DNN* YOLOv3_Module, ColorDetection* ColorDetection_Module, const int& colorRangeNum)
+{
+	auto& YOLOv3_Module_ = *YOLOv3_Module;
+	auto& ColorDetection_Module_ = *ColorDetection_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	int count = TestImageFileAdds.size();
+	cv::Mat testImg;
+	cv::Mat fullFrame;
+	cv::Mat sparseFrame;
+
+	long long fullElapsedTime = 0;
+	long long sparseElapsedTime = 0;
+	long long fullTouchedPixels = 0;
+	long long sparseTouchedPixels = 0;
+	int mismatchCount = 0;
+
+	//ؽƮ Ϸ 
+	std::ofstream writeT;
+	writeT.open("G_ColorSparse_Results.txt");
+	writeT << "Color Detection Sparse Evaluation Results\n";
+	writeT << "Image,FullTouched,SparseTouched,Full(us),Sparse(us),FullPixels,SparsePixels\n";
+
+	for (int i = 0; i < count; i++)
+	{
+		testImg = cv::imread(TestImageFileAdds[i]);
+
+		InBoxChecker fullInBoxChecker;
+		InBoxChecker sparseInBoxChecker;
+		YOLOv3_Module_.PassThrough(&testImg);
+		YOLOv3_Module_.GetObjectRects(&fullInBoxChecker);
+		YOLOv3_Module_.GetObjectRects(&sparseInBoxChecker);
+
+		//ٿø ũ  ϵ ÷  ̹ ũ ´
+		//ü ȯ
+		auto startTime = std::chrono::high_resolution_clock::now();
+		ColorDetection_Module_.MapHueFrameFromBGR(testImg, &fullFrame, nullptr, colorRangeNum);
+		cv::Mat fullFlagFrame = cv::Mat::zeros(testImg.rows, testImg.cols, CV_8UC1);
+		int fullPixels = ColorDetection_Module_.MakeBoxWithMedianBlur(&fullFrame, &fullFlagFrame, &fullInBoxChecker, "full");
+		auto endTime = std::chrono::high_resolution_clock::now();
+		long long fullTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+		// ȯ
+		startTime = std::chrono::high_resolution_clock::now();
+		int touched = ColorDetection_Module_.MapHueFrameSparse(testImg, &sparseFrame, &sparseInBoxChecker, colorRangeNum);
+		cv::Mat sparseFlagFrame = cv::Mat::zeros(testImg.rows, testImg.cols, CV_8UC1);
+		int sparsePixels = ColorDetection_Module_.MakeBoxWithMedianBlur(&sparseFrame, &sparseFlagFrame, &sparseInBoxChecker, "sparse");
+		endTime = std::chrono::high_resolution_clock::now();
+		long long sparseTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+		//ڽ ġ  ȼ  ƾ Ѵ
+		std::vector<InBoxChecker::BoxInfo> fullBoxes = fullInBoxChecker.GetBoxes(InBoxChecker::ColorDetection);
+		std::vector<InBoxChecker::BoxInfo> sparseBoxes = sparseInBoxChecker.GetBoxes(InBoxChecker::ColorDetection);
+		bool isSame = (fullPixels == sparsePixels) && (fullBoxes.size() == sparseBoxes.size());
+		for (size_t b = 0; isSame && (b < fullBoxes.size()); b++)
+		{
+			isSame = (fullBoxes[b].Box == sparseBoxes[b].Box);
+		}
+		if (isSame == false) mismatchCount++;
+
+		fullElapsedTime += fullTime;
+		sparseElapsedTime += sparseTime;
+		fullTouchedPixels += testImg.rows * testImg.cols;
+		sparseTouchedPixels += touched;
+
+		writeT << imageFileNames[i] << "," << testImg.rows * testImg.cols << "," << touched << "," << fullTime << "," << sparseTime << ","
+			<< fullPixels << "," << sparsePixels << "\n";
+	}
+	writeT.close();
+
+	int imageCount = std::max(1, count);
+	float touchedRatio = (fullTouchedPixels > 0) ? ((float)sparseTouchedPixels / fullTouchedPixels) : 0.0f;
+
+	std::cout << "touched pixels / full : " << fullTouchedPixels / imageCount << " / sparse : " << sparseTouchedPixels / imageCount
+		<< " (" << touchedRatio * 100.0f << "%) / full : " << fullElapsedTime / imageCount << "us / sparse : " << sparseElapsedTime / imageCount
+		<< "us / mismatch : " << mismatchCount << std::endl;
+}
+
+// ÷ ʿ FloodFill, Ͽ ε(1 ), Ͽ ε(threadCount ) ڽ 
+//ð ( ȼ , ڽ) Ѵ. ػ ī޶  ׽Ʈ ̹ upScale Ű ͵  
+void RobustOptimalExperiment::CompareColorLabelingExperiment(ColorDetection* ColorDetection_Module, const int& colorRangeNum,
+	const int& threadCount, const int& upScale)
+{
+	auto& ColorDetection_Module_ = *ColorDetection_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	int count = TestImageFileAdds.size();
+
+	//ؽƮ Ϸ 
+	std::ofstream writeT;
+	writeT.open("G_ColorLabeling_Results.txt");
+	writeT << "Color Labeling Results\n";
+	writeT << "Image,Scale,GridCells,FloodFill(us),UnionFind(us),UnionFindParallel(us),FloodPixels,UnionFindPixels,FloodBoxes,UnionFindBoxes,ParallelSame,FlagKept\n";
+
+	const int scales[2] = { 1, upScale };
+	for (int s = 0; s < 2; s++)
+	{
+		long long floodElapsedTime = 0;
+		long long unionFindElapsedTime = 0;
+		long long parallelElapsedTime = 0;
+		int resultMismatchCount = 0;
+		int parallelMismatchCount = 0;
+
+		for (int i = 0; i < count; i++)
+		{
+			cv::Mat testImg = cv::imread(TestImageFileAdds[i]);
+			if (scales[s] > 1)
+			{
+				cv::resize(testImg, testImg, cv::Size(testImg.cols * scales[s], testImg.rows * scales[s]), 0, 0, cv::InterpolationFlags::INTER_LINEAR);
+			}
+
+			//MakeBoxWithMedianBlur  (׸ + ׵θ ĭ) ÷  
+			cv::Mat hueMappedFrame;
+			cv::Mat gridFrame;
+			ColorDetection_Module_.MapHueFrameFromBGR(testImg, &hueMappedFrame, nullptr, colorRangeNum);
+			ColorDetection_Module_.DoGridMedianBlur(hueMappedFrame, &gridFrame, ColorDetection::Median_Histogram);
+			cv::Mat flagFrame = cv::Mat::zeros(gridFrame.rows + 2, gridFrame.cols + 2, CV_8UC1);
+			cv::Mat flagInner = flagFrame(cv::Rect(1, 1, gridFrame.cols, gridFrame.rows));
+			gridFrame.copyTo(flagInner);
+
+			InBoxChecker floodInBoxChecker;
+			InBoxChecker unionFindInBoxChecker;
+			InBoxChecker parallelInBoxChecker;
+			cv::Mat floodFlagFrame = flagFrame.clone();
+			cv::Mat unionFindFlagFrame = flagFrame.clone();
+			cv::Mat parallelFlagFrame = flagFrame.clone();
+
+			auto startTime = std::chrono::high_resolution_clock::now();
+			int floodPixels = ColorDetection_Module_.MakeBoxWithFloodFill(&floodFlagFrame, &floodInBoxChecker, testImg.rows, testImg.cols, "flood");
+			auto endTime = std::chrono::high_resolution_clock::now();
+			long long floodTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+			startTime = std::chrono::high_resolution_clock::now();
+			int unionFindPixels = ColorDetection_Module_.MakeBoxWithUnionFind(&unionFindFlagFrame, &unionFindInBoxChecker, testImg.rows, testImg.cols, "unionFind", 1);
+			endTime = std::chrono::high_resolution_clock::now();
+			long long unionFindTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+			startTime = std::chrono::high_resolution_clock::now();
+			int parallelPixels = ColorDetection_Module_.MakeBoxWithUnionFind(&parallelFlagFrame, &parallelInBoxChecker, testImg.rows, testImg.cols, "parallel", threadCount);
+			endTime = std::chrono::high_resolution_clock::now();
+			long long parallelTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count();
+
+			std::vector<InBoxChecker::BoxInfo> floodBoxes = floodInBoxChecker.GetBoxes(InBoxChecker::ColorDetection);
+			std::vector<InBoxChecker::BoxInfo> unionFindBoxes = unionFindInBoxChecker.GetBoxes(InBoxChecker::ColorDetection);
+			std::vector<InBoxChecker::BoxInfo> parallelBoxes = parallelInBoxChecker.GetBoxes(InBoxChecker::ColorDetection);
+
+			//FloodFill ڽ ŭ ǳʶٴ ĵ /Ʒ  ĭ Ž    ٸ  ִ
+			bool isSameResult = (floodPixels == unionFindPixels) && (floodBoxes.size() == unionFindBoxes.size());
+			for (size_t b = 0; isSameResult && (b < floodBoxes.size()); b++)
+			{
+				isSameResult = (floodBoxes[b].Box == unionFindBoxes[b].Box);
+			}
+			if (isSameResult == false) resultMismatchCount++;
+
+			//  ׻ 1   ƾ Ѵ
+			bool isParallelSame = (parallelPixels == unionFindPixels) && (parallelBoxes.size() == unionFindBoxes.size());
+			for (size_t b = 0; isParallelSame && (b < parallelBoxes.size()); b++)
+			{
+				isParallelSame = (parallelBoxes[b].Box == unionFindBoxes[b].Box);
+			}
+			if (isParallelSame == false) parallelMismatchCount++;
+
+			//Ͽ ε ÷  ǵ帮 ʴ´
+			bool isFlagKept = (cv::countNonZero(unionFindFlagFrame != flagFrame) == 0) && (cv::countNonZero(parallelFlagFrame != flagFrame) == 0);
+
+			floodElapsedTime += floodTime;
+			unionFindElapsedTime += unionFindTime;
+			parallelElapsedTime += parallelTime;
+
+			writeT << imageFileNames[i] << "," << scales[s] << "," << gridFrame.rows * gridFrame.cols << "," << floodTime << "," << unionFindTime << "," << parallelTime << ","
+				<< floodPixels << "," << unionFindPixels << "," << floodBoxes.size() << "," << unionFindBoxes.size() << ","
+				<< (isParallelSame ? 1 : 0) << "," << (isFlagKept ? 1 : 0) << "\n";
+		}
+
+		int imageCount = std::max(1, count);
+		std::cout << "labeling x" << scales[s] << " / flood : " << floodElapsedTime / imageCount << "us / union find : " << unionFindElapsedTime / imageCount
+			<< "us / union find(" << threadCount << " threads) : " << parallelElapsedTime / imageCount << "us / flood mismatch : " << resultMismatchCount
+			<< " / parallel mismatch : " << parallelMismatchCount << std::endl;
+	}
+	writeT.close();
+}
+
+//   1 maxThreadCount ÷ PushThroughImage ó(/) .
+//۰  (HSV  ,  ǥ ) , 1    ζ  װͰ  ȮѴ.
+//MakeBoxWithBands   ð  ´. ػ ī޶  ׽Ʈ ̹ upScale Ű 
+void RobustOptimalExperiment::DoColorBandScalingExperiment(ColorDetection* ColorDetection_Module, const int& colorRangeNum,
+	const int& maxThreadCount, const int& upScale, const int& repeatCount)
+{
+	auto& ColorDetection_Module_ = *ColorDetection_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	//׽Ʈ ̹ ̸ а Űд
+	int count = TestImageFileAdds.size();
+	std::vector<cv::Mat> testImgs(count);
+	for (int i = 0; i < count; i++)
+	{
+		cv::Mat testImg = cv::imread(TestImageFileAdds[i]);
+		cv::resize(testImg, testImgs[i], cv::Size(testImg.cols * upScale, testImg.rows * upScale), 0, 0, cv::InterpolationFlags::INTER_LINEAR);
+	}
+
+	int originalBandThreadCount = ColorDetection_Module_.GetBandThreadCount();
+	bool originalDebugDisplay = ColorDetection_Module_.IsDebugDisplay();
+	ColorDetection_Module_.SetTiledExecution(false);
+	ColorDetection_Module_.SetDebugDisplay(false);
+
+	//ؽƮ Ϸ 
+	std::ofstream writeT;
+	writeT.open("G_ColorBand_Scaling.txt");
+	writeT << "Color Detection Band Scaling (x" << upScale << ")\n";
+	writeT << "Threads,Time(us/frame),Frames/s,SpeedUp,Efficiency,BandKernel(us/frame),Mismatch\n";
+
+	std::vector<int> referencePixels(count);
+	std::vector<std::vector<InBoxChecker::BoxInfo>> referenceBoxes(count);
+	cv::Mat boxFlagFrame;
+	double singleThreadTime = 0.0;
+
+	for (int t = 1; t <= maxThreadCount; t++)
+	{
+		ColorDetection_Module_.SetBandThreadCount(t);
+		int mismatchCount = 0;
+
+		auto startTime = std::chrono::high_resolution_clock::now();
+		for (int k = 0; k < repeatCount; k++)
+		{
+			for (int i = 0; i < count; i++)
+			{
+				InBoxChecker inBoxChecker;
+				int detectedPixels = ColorDetection_Module_.PushThroughImage(testImgs[i], nullptr, &inBoxChecker, colorRangeNum);
+
+				if (k > 0) continue;
+				std::vector<InBoxChecker::BoxInfo> boxes = inBoxChecker.GetBoxes(InBoxChecker::ColorDetection);
+				if (t == 1)
+				{
+					referencePixels[i] = detectedPixels;
+					referenceBoxes[i] = boxes;
+					continue;
+				}
+
+				bool isSame = (detectedPixels == referencePixels[i]) && (boxes.size() == referenceBoxes[i].size());
+				for (size_t b = 0; isSame && (b < boxes.size()); b++)
+				{
+					isSame = (boxes[b].Box == referenceBoxes[i][b].Box);
+				}
+				if (isSame == false) mismatchCount++;
+			}
+		}
+		auto endTime = std::chrono::high_resolution_clock::now();
+		double frameTime = (double)std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / std::max(1, count * repeatCount);
+
+		//÷  Ҵ  б⸦   Ŀθ ð
+		startTime = std::chrono::high_resolution_clock::now();
+		for (int k = 0; k < repeatCount; k++)
+		{
+			for (int i = 0; i < count; i++)
+			{
+				InBoxChecker inBoxChecker;
+				ColorDetection_Module_.MakeBoxWithBands(testImgs[i], nullptr, &boxFlagFrame, &inBoxChecker, colorRangeNum);
+			}
+		}
+		endTime = std::chrono::high_resolution_clock::now();
+		double kernelTime = (double)std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / std::max(1, count * repeatCount);
+
+		if (t == 1) singleThreadTime = frameTime;
+		double framesPerSecond = (frameTime > 0.0) ? 1000000.0 / frameTime : 0.0;
+		double speedUp = (frameTime > 0.0) ? singleThreadTime / frameTime : 0.0;
+
+		writeT << t << "," << frameTime << "," << framesPerSecond << "," << speedUp << "," << speedUp / t << "," << kernelTime << "," << mismatchCount << "\n";
+		std::cout << "band threads : " << t << " / " << frameTime << "us / " << framesPerSecond << " fps / x" << speedUp
+			<< " / efficiency : " << speedUp / t * 100.0 << "% / band kernel : " << kernelTime << "us / mismatch : " << mismatchCount << std::endl;
+	}
+	writeT.close();
+
+	ColorDetection_Module_.SetBandThreadCount(originalBandThreadCount);
+	ColorDetection_Module_.SetDebugDisplay(originalDebugDisplay);
+}
+
+//Ÿ ġũ  ڽ. ĳ ũ  Ÿ 迡 ġ     ΰ
+//밢   ڽ  ڽ ִ´. Ÿ ΰ ׸  ȹ Ÿϸ ̾ д Ȯϴ 뵵
+static void addTileStraddlingBoxes(const cv::Mat& frame, InBoxChecker* inBoxChecker)
+{
+	auto& inBoxChecker_ = *inBoxChecker;
+
+	inBoxChecker_.AddBox(cv::Rect(frame.cols * 2 / 5, 0, std::max(1, frame.cols / 5), frame.rows), InBoxChecker::YOLOv3, "straddle");
+	inBoxChecker_.AddBox(cv::Rect(0, frame.rows * 2 / 5, frame.cols, std::max(1, frame.rows / 10)), InBoxChecker::YOLOv3, "straddle");
+	for (int k = 1; k < 8; k++)
+	{
+		inBoxChecker_.AddBox(cv::Rect(frame.cols * k / 8 - frame.cols / 14, frame.rows * k / 8 - frame.rows / 14,
+			std::max(1, frame.cols / 7), std::max(1, frame.rows / 7)), InBoxChecker::YOLOv3, "straddle");
+	}
+}
+
+// 忡 ܰ躰 ü  (MapHueFrameFromBGR + MakeBoxWithMedianBlur) Ÿ (MakeBoxWithTiles)
+//Ÿ ĳ ũ⺰ Ѵ. ػ ī޶  ׽Ʈ ̹ upScale Ű .
+//ð  ιڽüĿ ,  񱳴 Ÿ 迡 ģ  ڽ  쵵  
+void RobustOptimalExperiment::DoColorTileBenchmark(ColorDetection* ColorDetection_Module, const int& colorRangeNum,
+	const int& upScale, const int& repeatCount)
+{
+	auto& ColorDetection_Module_ = *ColorDetection_Module;
+
+	std::vector<std::string> imageFileNames;
+	std::vector<std::string> TestImageFileAdds = getFilenames("./testImages_resized", &imageFileNames);
+
+	//׽Ʈ ̹ ̸ а Űд
+	int count = TestImageFileAdds.size();
+	std::vector<cv::Mat> testImgs(count);
+	long long totalPixels = 0;
+	for (int i = 0; i < count; i++)
+	{
+		cv::Mat testImg = cv::imread(TestImageFileAdds[i]);
+		cv::resize(testImg, testImgs[i], cv::Size(testImg.cols * upScale, testImg.rows * upScale), 0, 0, cv::InterpolationFlags::INTER_LINEAR);
+		totalPixels += testImgs[i].rows * testImgs[i].cols;
+	}
+
+	int originalBandThreadCount = ColorDetection_Module_.GetBandThreadCount();
+	ColorDetection_Module_.SetBandThreadCount(1);
+
+	//ܰ躰   ð
+	std::vector<cv::Mat> referenceFlagFrames(count);
+	std::vector<int> referencePixels(count);
+	std::vector<std::vector<InBoxChecker::BoxInfo>> referenceBoxes(count);
+	cv::Mat hueMappedFrame;
+
+	//÷  ũ Ÿ ο ޾ƿ´
+	for (int i = 0; i < count; i++)
+	{
+		InBoxChecker inBoxChecker;
+		cv::Mat boxFlagFrame;
+		ColorDetection_Module_.MakeBoxWithTiles(testImgs[i], &boxFlagFrame, &inBoxChecker, colorRangeNum);
+		referenceFlagFrames[i] = cv::Mat::zeros(boxFlagFrame.rows, boxFlagFrame.cols, CV_8UC1);
+	}
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	for (int k = 0; k < repeatCount; k++)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			InBoxChecker inBoxChecker;
+			ColorDetection_Module_.MapHueFrameFromBGR(testImgs[i], &hueMappedFrame, nullptr, colorRangeNum);
+			referenceFlagFrames[i].setTo(cv::Scalar(0));
+			referencePixels[i] = ColorDetection_Module_.MakeBoxWithMedianBlur(&hueMappedFrame, &referenceFlagFrames[i], &inBoxChecker, "reference");
+			if (k == 0) referenceBoxes[i] = inBoxChecker.GetBoxes(InBoxChecker::ColorDetection);
+		}
+	}
+	auto endTime = std::chrono::high_resolution_clock::now();
+	double referenceTime = (double)std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / std::max(1, count * repeatCount);
+
+	// ڽ   ܰ躰  
+	std::vector<cv::Mat> seededFlagFrames(count);
+	std::vector<int> seededPixels(count);
+	std::vector<std::vector<InBoxChecker::BoxInfo>> seededBoxes(count);
+	for (int i = 0; i < count; i++)
+	{
+		InBoxChecker inBoxChecker;
+		addTileStraddlingBoxes(testImgs[i], &inBoxChecker);
+		ColorDetection_Module_.MapHueFrameFromBGR(testImgs[i], &hueMappedFrame, nullptr, colorRangeNum);
+		seededFlagFrames[i] = cv::Mat::zeros(referenceFlagFrames[i].rows, referenceFlagFrames[i].cols, CV_8UC1);
+		seededPixels[i] = ColorDetection_Module_.MakeBoxWithMedianBlur(&hueMappedFrame, &seededFlagFrames[i], &inBoxChecker, "reference");
+		seededBoxes[i] = inBoxChecker.GetBoxes(InBoxChecker::ColorDetection);
+	}
+
+	//ؽƮ Ϸ 
+	std::ofstream writeT;
+	writeT.open("G_ColorTile_Benchmark.txt");
+	writeT << "Color Detection Tile Benchmark (x" << upScale << ")\n";
+	writeT << "TileCache(KB),Time(us/frame),SpeedUp,TouchedPixels/Frame,Mismatch,StraddlingBoxMismatch\n";
+	writeT << "untiled," << referenceTime << ",1,1,0,0\n";
+	std::cout << "untiled : " << referenceTime << "us" << std::endl;
+
+	const int tileCacheKBs[] = { 64, 128, 256, 512, 1024, 2048 };
+	for (int t = 0; t < 6; t++)
+	{
+		ColorDetection_Module_.SetTiledExecution(true, tileCacheKBs[t] * 1024);
+		int mismatchCount = 0;
+		long long touchedPixels = 0;
+		cv::Mat boxFlagFrame;
+
+		startTime = std::chrono::high_resolution_clock::now();
+		for (int k = 0; k < repeatCount; k++)
+		{
+			for (int i = 0; i < count; i++)
+			{
+				InBoxChecker inBoxChecker;
+				int detectedPixels = ColorDetection_Module_.MakeBoxWithTiles(testImgs[i], &boxFlagFrame, &inBoxChecker, colorRangeNum);
+
+				if (k > 0) continue;
+				touchedPixels += ColorDetection_Module_.GetLastTouchedPixelCount();
+
+				//÷ ʰ ڽ,  ȼ  ܰ躰 ο ƾ Ѵ
+				std::vector<InBoxChecker::BoxInfo> boxes = inBoxChecker.GetBoxes(InBoxChecker::ColorDetection);
+				bool isSame = (detectedPixels == referencePixels[i]) && (cv::countNonZero(boxFlagFrame != referenceFlagFrames[i]) == 0)
+					&& (boxes.size() == referenceBoxes[i].size());
+				for (size_t b = 0; isSame && (b < boxes.size()); b++)
+				{
+					isSame = (boxes[b].Box == referenceBoxes[i][b].Box);
+				}
+				if (isSame == false) mismatchCount++;
+			}
+		}
+		endTime = std::chrono::high_resolution_clock::now();
+
+		//Ÿ 迡 ģ  ڽ  ƾ Ѵ
+		int seededMismatchCount = 0;
+		for (int i = 0; i < count; i++)
+		{
+			InBoxChecker inBoxChecker;
+			addTileStraddlingBoxes(testImgs[i], &inBoxChecker);
+			int detectedPixels = ColorDetection_Module_.MakeBoxWithTiles(testImgs[i], &boxFlagFrame, &inBoxChecker, colorRangeNum);
+
+			std::vector<InBoxChecker::BoxInfo> boxes = inBoxChecker.GetBoxes(InBoxChecker::ColorDetection);
+			bool isSame = (detectedPixels == seededPixels[i]) && (cv::countNonZero(boxFlagFrame != seededFlagFrames[i]) == 0)
+				&& (boxes.size() == seededBoxes[i].size());
+			for (size_t b = 0; isSame && (b < boxes.size()); b++)
+			{
+				isSame = (boxes[b].Box == seededBoxes[i][b].Box);
+			}
+			if (isSame == false) seededMismatchCount++;
+		}
+
+		double tileTime = (double)std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / std::max(1, count * repeatCount);
+		double speedUp = (tileTime > 0.0) ? referenceTime / tileTime : 0.0;
+		double touchedRatio = (totalPixels > 0) ? (double)touchedPixels / totalPixels : 0.0;
+
+		writeT << tileCacheKBs[t] << "," << tileTime << "," << speedUp << "," << touchedRatio << "," << mismatchCount << "," << seededMismatchCount << "\n";
+		std::cout << "tile cache : " << tileCacheKBs[t] << "KB / " << tileTime << "us / x" << speedUp
+			<< " / touched : " << touchedRatio * 100.0 << "% / mismatch : " << mismatchCount
+			<< " / straddling box mismatch : " << seededMismatchCount << std::endl;
+	}
+	writeT.close();
+
+	ColorDetection_Module_.SetTiledExecution(false);
+	ColorDetection_Module_.SetBandThreadCount(originalBandThreadCount);
 }
\ No newline at end of file
@@ -15,6 +15,7 @@
 
 #include "InBoxChecker_Tool.hpp"
 #include "YOLO_v3_Module.hpp"
+#include "YOLOPool_Tool.hpp"
 #include "ColorDetection_Module.hpp"
 #include "GrayScale_Module.hpp"
 
@@ -105,4 +106,26 @@ public:
 	void SaveAnswer_AreaRatio_txt(const std::string& folder);
 	void SaveColorDetection_DetectionBox_txt(ColorDetection* ColorDetection_Module,
 		const int& hueMargin, const int& medianFilterSize, const int& downSamplingSize);
+
+	void CompareYoloBatchExperiment(YOLO_v3_DNN* YOLOv3_Module, const int& batchSize);
+	void DoYoloPostProcessBenchmark(YOLO_v3_DNN* YOLOv3_Module, const float& confidenceThreshold, const int& repeatCount);
+	void DoYoloNMSBenchmark(YOLO_v3_DNN* YOLOv3_Module, const int& repeatCount);
+	void DoYoloPreprocessBenchmark(YOLO_v3_DNN* YOLOv3_Module, const int& repeatCount);
+	void DoYoloLayerProfileExperiment(YOLO_v3_DNN* YOLOv3_Module, const int& repeatCount);
+	void CompareYoloTiledExperiment(YOLO_v3_DNN* YOLOv3_Module, const int& tileOverlap);
+	void CompareYoloOutputHeadsExperiment(YOLO_v3_DNN* YOLOv3_Module);
+	void CompareYoloQuantizedExperiment(YOLO_v3_DNN* YOLOv3_Module, YOLO_v3_DNN* quantizedYOLOv3_Module,
+		const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights, const int& calibrationCount);
+	void CompareYoloTrackingExperiment(YOLO_v3_DNN* YOLOv3_Module, const int& trackingInterval, const int& sequenceLength);
+	void CompareYoloPoolExperiment(YOLO_v3_Pool* YOLOv3_Pool);
+	void DoColorHueMappingBenchmark(ColorDetection* ColorDetection_Module, const int& colorRangeNum, const int& repeatCount);
+	void DoColorConversionBenchmark(ColorDetection* ColorDetection_Module, const int& colorRangeNum, const int& repeatCount);
+	void DoColorMedianBenchmark(ColorDetection* ColorDetection_Module, const int& colorRangeNum, const int& repeatCount);
+	void CompareColorSparseExperiment(YOLO_v3_DNN* YOLOv3_Module, ColorDetection* ColorDetection_Module, const int& colorRangeNum);
+	void CompareColorLabelingExperiment(ColorDetection* ColorDetection_Module, const int& colorRangeNum,
+		const int& threadCount = 4, const int& upScale = 4);
+	void DoColorBandScalingExperiment(ColorDetection* ColorDetection_Module, const int& colorRangeNum,
+		const int& maxThreadCount, const int& upScale = 4, const int& repeatCount = 5);
+	void DoColorTileBenchmark(ColorDetection* ColorDetection_Module, const int& colorRangeNum,
+		const int& upScale = 4, const int& repeatCount = 5);
 };
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+class ThreadPool
+{
+private:
+	std::vector<std::thread> mWorkers;
+	std::mutex mMutex;
+	std::mutex mRunMutex;
+	std::condition_variable mWorkCondition;
+	std::condition_variable mDoneCondition;
+
+	const std::function<void(int)>* mTask = nullptr;
+	int mTaskCount = 0;
+	int mNextTask = 0;
+	int mPendingTaskCount = 0;
+	unsigned int mGeneration = 0;
+	bool mbStop = false;
+
+	bool runNextTask(std::unique_lock<std::mutex>* lock);
+	void workerLoop();
+
+public:
+	// threadCount includes the calling thread; 0 = hardware concurrency
+	ThreadPool(const int& threadCount = 0);
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Runs task(0) ... task(taskCount - 1) on the workers and the calling thread, returns when all are done
+	void ParallelFor(const int& taskCount, const std::function<void(int)>& task);
+	int GetThreadCount();
+};
+
+//. ȣ 嵵 ۾  ϹǷ Ŀ threadCount - 1 
+ThreadPool::ThreadPool(const int& threadCount)
+{
+	int totalThreadCount = (threadCount > 0) ? threadCount : (int)std::thread::hardware_concurrency();
+	for (int t = 1; t < totalThreadCount; t++)
+	{
+		mWorkers.push_back(std::thread(&ThreadPool::workerLoop, this));
+	}
+}
+
+//Ҹ. Ŀ  
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mbStop = true;
+	}
+	mWorkCondition.notify_all();
+
+	for (size_t t = 0; t < mWorkers.size(); t++)
+	{
+		mWorkers[t].join();
+	}
+}
+
+// ۾ ϳ ͼ Ѵ. ۾ ߿  Ǯд.  ۾  false
+bool ThreadPool::runNextTask(std::unique_lock<std::mutex>* lock)
+{
+	auto& lock_ = *lock;
+
+	if (mNextTask >= mTaskCount)
+	{
+		return false;
+	}
+
+	int taskIndex = mNextTask++;
+	const std::function<void(int)>& task = *mTask;
+
+	lock_.unlock();
+	task(taskIndex);
+	lock_.lock();
+
+	if (--mPendingTaskCount == 0)
+	{
+		mDoneCondition.notify_all();
+	}
+	return true;
+}
+
+//Ŀ .  ParallelFor   ٷȴٰ ۾   
+void ThreadPool::workerLoop()
+{
+	unsigned int seenGeneration = 0;
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	while (true)
+	{
+		mWorkCondition.wait(lock, [&]() { return mbStop || (mGeneration != seenGeneration); });
+		if (mbStop)
+		{
+			return;
+		}
+
+		seenGeneration = mGeneration;
+		while (runNextTask(&lock)) {}
+	}
+}
+
+//task(0) ~ task(taskCount - 1) Ŀ ȣ 尡  ϰ,   ƿ´.
+// 忡 ÿ ҷ ѹ ϳ ȴ
+void ThreadPool::ParallelFor(const int& taskCount, const std::function<void(int)>& task)
+{
+	if (taskCount <= 0)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> runLock(mRunMutex);
+	std::unique_lock<std::mutex> lock(mMutex);
+
+	mTask = &task;
+	mTaskCount = taskCount;
+	mNextTask = 0;
+	mPendingTaskCount = taskCount;
+	mGeneration++;
+	mWorkCondition.notify_all();
+
+	while (runNextTask(&lock)) {}
+	mDoneCondition.wait(lock, [&]() { return mPendingTaskCount == 0; });
+
+	mTask = nullptr;
+	mTaskCount = 0;
+}
+
+//ȣ 带   
+int ThreadPool::GetThreadCount()
+{
+	return (int)mWorkers.size() + 1;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+class ThreadPool
+{
+private:
+	std::vector<std::thread> mWorkers;
+	std::mutex mMutex;
+	std::mutex mRunMutex;
+	std::condition_variable mWorkCondition;
+	std::condition_variable mDoneCondition;
+
+	const std::function<void(int)>* mTask = nullptr;
+	int mTaskCount = 0;
+	int mNextTask = 0;
+	int mPendingTaskCount = 0;
+	unsigned int mGeneration = 0;
+	bool mbStop = false;
+
+	bool runNextTask(std::unique_lock<std::mutex>* lock);
+	void workerLoop();
+
+public:
+	// threadCount includes the calling thread; 0 = hardware concurrency
+	ThreadPool(const int& threadCount = 0);
+	~ThreadPool();
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	// Runs task(0) ... task(taskCount - 1) on the workers and the calling thread, returns when all are done
+	void ParallelFor(const int& taskCount, const std::function<void(int)>& task);
+	int GetThreadCount();
+};
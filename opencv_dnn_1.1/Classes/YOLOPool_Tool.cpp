@@ -0,0 +1,184 @@
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+
+#include <opencv2/core.hpp>
+
+#include "InBoxChecker_Tool.hpp"
+#include "YOLO_v3_Module.hpp"
+#include "MappedFile_Tool.hpp"
+
+class YOLO_v3_Pool
+{
+private:
+	float mConfThreshold;
+	float mNMSThreshold;
+	int mInpWidth;
+	int mInpHeight;
+
+	std::vector<std::shared_ptr<YOLO_v3_DNN>> mReplicas;
+	std::vector<int> mFreeReplicas;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+
+	int acquireReplica();
+	void releaseReplica(const int& replicaIndex);
+
+public:
+	YOLO_v3_Pool(const float& confThreshold = 0.2, const float& nmsThreshold = 0.4, const int& inpWidth = 416, const int& inpHeight = 416);
+
+	bool MakePoolFromFile(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights,
+		const int& replicaCount);
+	bool PassThrough(const cv::Mat& currFrame, YOLO_v3_DNN::DetectionResult* detection);
+	bool PassThroughAll(const std::vector<cv::Mat>& frames, std::vector<YOLO_v3_DNN::DetectionResult>* detections);
+	int GetObjectRects(const YOLO_v3_DNN::DetectionResult& detection, InBoxChecker* inBoxChecker);
+	int GetReplicaCount();
+};
+
+//.    Ȧ Է ũ⸦ 
+YOLO_v3_Pool::YOLO_v3_Pool(const float& confThreshold, const float& nmsThreshold, const int& inpWidth, const int& inpHeight)
+{
+	mConfThreshold = confThreshold;
+	mNMSThreshold = nmsThreshold;
+	mInpWidth = inpWidth;
+	mInpHeight = inpHeight;
+}
+
+//cfg, weights  ѹ ޸ ϰ  ۷ replicaCount Ʈũ .
+//OpenCV Ʈũ forward ߿  ۸ Ƿ 帶  ־ ϰ, ġ Ʈũ ȴ.
+bool YOLO_v3_Pool::MakePoolFromFile(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights,
+	const int& replicaCount)
+{
+	if (replicaCount < 1)
+	{
+		return false;
+	}
+
+	MappedFile cfgFile;
+	MappedFile weightsFile;
+	if ((cfgFile.Open(modelConfiguration) == false) || (weightsFile.Open(modelWeights) == false))
+	{
+		std::cerr << "Can't read the model files for the pool: " << std::endl;
+		std::cerr << "cfg-file:     " << modelConfiguration << std::endl;
+		std::cerr << "weights-file: " << modelWeights << std::endl;
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	mReplicas.clear();
+	mFreeReplicas.clear();
+
+	for (int i = 0; i < replicaCount; i++)
+	{
+		auto replica = std::make_shared<YOLO_v3_DNN>(mConfThreshold, mNMSThreshold, mInpWidth, mInpHeight);
+		if (replica->MakeYOLONetFromMemory(classesFile, modelConfiguration, modelWeights,
+			cfgFile.GetData(), cfgFile.GetSize(), weightsFile.GetData(), weightsFile.GetSize()) == false)
+		{
+			mReplicas.clear();
+			mFreeReplicas.clear();
+			return false;
+		}
+
+		mReplicas.push_back(replica);
+		mFreeReplicas.push_back(i);
+	}
+
+	return true;
+}
+
+// ִ  ϳ .  ̸ ݳɶ ٸ
+int YOLO_v3_Pool::acquireReplica()
+{
+	std::unique_lock<std::mutex> lock(mMutex);
+	mCondition.wait(lock, [this]() { return mFreeReplicas.empty() == false; });
+
+	int replicaIndex = mFreeReplicas.back();
+	mFreeReplicas.pop_back();
+
+	return replicaIndex;
+}
+
+//  ݳѴ
+void YOLO_v3_Pool::releaseReplica(const int& replicaIndex)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mFreeReplicas.push_back(replicaIndex);
+	}
+	mCondition.notify_one();
+}
+
+// ִ   ϳ Ų.  忡 ÿ ҷ ȴ.
+// û Ѱܹ detection Ƿ 峢   ʴ´.
+bool YOLO_v3_Pool::PassThrough(const cv::Mat& currFrame, YOLO_v3_DNN::DetectionResult* detection)
+{
+	if (mReplicas.empty())
+	{
+		std::cerr << "the YOLO pool is empty!" << std::endl;
+		std::cerr << "make the pool with MakePoolFromFile before use this function" << std::endl;
+		return false;
+	}
+
+	int replicaIndex = acquireReplica();
+	bool isSuccess = mReplicas[replicaIndex]->PassThrough(currFrame, detection);
+	releaseReplica(replicaIndex);
+
+	return isSuccess;
+}
+
+//  (ī޶  )  ŭ   ÿ Ų
+bool YOLO_v3_Pool::PassThroughAll(const std::vector<cv::Mat>& frames, std::vector<YOLO_v3_DNN::DetectionResult>* detections)
+{
+	auto& detections_ = *detections;
+
+	detections_.clear();
+	detections_.resize(frames.size());
+
+	std::atomic<int> nextFrame(0);
+	std::atomic<bool> isAllSuccess(true);
+
+	int threadCount = std::min((int)mReplicas.size(), (int)frames.size());
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threadCount; t++)
+	{
+		workers.push_back(std::thread([&]()
+		{
+			int frameIndex;
+			while ((frameIndex = nextFrame++) < (int)frames.size())
+			{
+				if (PassThrough(frames[frameIndex], &detections_[frameIndex]) == false)
+				{
+					isAllSuccess = false;
+				}
+			}
+		}));
+	}
+
+	for (size_t t = 0; t < workers.size(); t++)
+	{
+		workers[t].join();
+	}
+
+	return isAllSuccess && (mReplicas.empty() == false);
+}
+
+// Rect ιڽüĿ Ѵ. Ŭ ̸ Ƿ ƹ ̳ 
+int YOLO_v3_Pool::GetObjectRects(const YOLO_v3_DNN::DetectionResult& detection, InBoxChecker* inBoxChecker)
+{
+	if (mReplicas.empty())
+	{
+		return 0;
+	}
+
+	return mReplicas[0]->GetObjectRects(detection, inBoxChecker);
+}
+
+int YOLO_v3_Pool::GetReplicaCount()
+{
+	return (int)mReplicas.size();
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <iostream>
+
+#include <opencv2/core.hpp>
+
+#include "InBoxChecker_Tool.hpp"
+#include "YOLO_v3_Module.hpp"
+#include "MappedFile_Tool.hpp"
+
+class YOLO_v3_Pool
+{
+private:
+	float mConfThreshold;
+	float mNMSThreshold;
+	int mInpWidth;
+	int mInpHeight;
+
+	std::vector<std::shared_ptr<YOLO_v3_DNN>> mReplicas;
+	std::vector<int> mFreeReplicas;
+	std::mutex mMutex;
+	std::condition_variable mCondition;
+
+	int acquireReplica();
+	void releaseReplica(const int& replicaIndex);
+
+public:
+	YOLO_v3_Pool(const float& confThreshold = 0.2, const float& nmsThreshold = 0.4, const int& inpWidth = 416, const int& inpHeight = 416);
+
+	bool MakePoolFromFile(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights,
+		const int& replicaCount);
+	bool PassThrough(const cv::Mat& currFrame, YOLO_v3_DNN::DetectionResult* detection);
+	bool PassThroughAll(const std::vector<cv::Mat>& frames, std::vector<YOLO_v3_DNN::DetectionResult>* detections);
+	int GetObjectRects(const YOLO_v3_DNN::DetectionResult& detection, InBoxChecker* inBoxChecker);
+	int GetReplicaCount();
+};
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <opencv2\core.hpp>
 #include <opencv2\highgui.hpp>
 #include <opencv2\imgproc\imgproc.hpp>
+#include <opencv2/core/hal/intrin.hpp>
 
 
 #include <stdio.h>
@@ -12,52 +13,291 @@
 #include <math.h>
 #include <algorithm> 
 #include <queue>
+#include <map>
+#include <memory>
+#include <float.h>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <sstream>
 #include <iostream>
 #include <fstream>
 
 #include "InBoxChecker_Tool.hpp"
+#include "DNNOutputCache_Tool.hpp"
+#include "MappedFile_Tool.hpp"
 
 
 
 class YOLO_v3_DNN
 {
+public:
+	enum eNMSMode { NMS_ClassAgnostic = 0, NMS_PerClass = 1 };
+	// Output heads in network order. Stride 32 is the coarsest grid (large objects), stride 8 the finest (small objects)
+	enum eOutputHeads { Head_Stride32 = 1, Head_Stride16 = 2, Head_Stride8 = 4, Head_All = 7 };
+	struct DetectionResult
+	{
+		std::vector<int> ClassIds;
+		std::vector<float> Confidences;
+		std::vector<cv::Rect> Boxes;
+		std::vector<int> Indices;
+	};
+	struct StartupProfile
+	{
+		double ParseTime;       // ms, mapping the files + building the net from the buffers
+		double AllocateTime;    // ms, first forward on a dummy blob (layer setup, blob allocation)
+		double WarmUpTime;      // ms, second forward on a dummy blob (steady state)
+		double TotalTime;       // ms, sum of the above = time until the net is ready for the first frame
+	};
+	struct LayerProfile
+	{
+		std::string Name;
+		std::string Type;
+		double MinTime;         // ms
+		double MeanTime;        // ms
+		double P95Time;         // ms
+	};
+	struct InferenceProfile
+	{
+		int FrameCount;
+		double MinTotal;        // ms, whole forward
+		double MeanTotal;
+		double P95Total;
+		std::vector<LayerProfile> Layers; // Network order
+	};
+	struct AsyncResult
+	{
+		int FrameId;
+		DetectionResult Detection;
+		double QueueLatency;    // ms, SubmitFrame ~ forward start
+		double InferenceTime;   // ms, forward + post processing
+		double TotalLatency;    // ms, SubmitFrame ~ result ready
+	};
 private:
 	float mConfThreshold = 0.2; // Confidence threshold
 	float mNMSThreshold = 0.4;  // Non-maximum suppression threshold
 	int mInpWidth = 416;        // Width of network's input image
 	int mInpHeight = 416;       // Height of network's input image
+	int mBatchSize = 8;         // Number of frames per forward pass in batch mode
+	int mTileOverlap = 64;      // Overlap between neighbouring tiles in tiled mode (pixel)
+	int mOutputHeads = Head_All; // eOutputHeads flags of the heads to forward
+	bool mbQuantized = false;   // Network was quantized to INT8 from the float model
+	int mTrackingInterval = 5;  // Run YOLO every N frames in tracking mode
+	float mSceneChangeThreshold = 12.0f; // Mean gray difference from the last YOLO frame that forces a YOLO run
+
+	eNMSMode mNMSMode = NMS_ClassAgnostic;
+	int mNMSTopK = 0;           // Maximum kept boxes after NMS, 0 = no limit
+	bool mbSoftNMS = false;
+	float mSoftNMSSigma = 0.5f;
 
 	cv::dnn::Net mNeuralNet;
+	std::string mModelConfiguration;
+	std::string mModelWeights;
+	std::shared_ptr<DNNOutputCache> mDiskCache;
+	std::vector<std::string> mOutputNames;
+	StartupProfile mStartupProfile = {};
+
+	bool mbLayerProfiling = false;
+	int mProfileWindow = 100;   // Number of latest forwards kept for the layer statistics
+	std::vector<std::string> mProfileLayerNames;
+	std::vector<std::string> mProfileLayerTypes;
+	std::deque<std::vector<double>> mProfileSamples; // Per forward, per layer time (ms)
+	std::deque<double> mProfileTotals;
 
 	cv::Mat mBlob;
+	cv::Mat mResizedFrame;
+	int mPreprocessReallocCount = 0;
 	std::vector<cv::Mat> mOuts;
+	std::map<std::string, std::vector<cv::Mat>> mOutsCache;
 	cv::Mat mDetectedFrame;
 
-	std::vector<int> mClassIds;
-	std::vector<float> mConfidences;
-	std::vector<cv::Rect> mBoxes;
+	DetectionResult mDetection;
+	DetectionResult mTrackedDetection;
 	std::vector<std::string> mClasses;
-	std::vector<int> mIndices;
+
+	struct meCandidateBuffer
+	{
+		std::vector<int> mClassIds;
+		std::vector<float> mConfidences;
+		std::vector<int> mLefts;
+		std::vector<int> mTops;
+		std::vector<int> mWidths;
+		std::vector<int> mHeights;
+	};
+
+	struct meKeptBoxes
+	{
+		std::vector<float> mX1;
+		std::vector<float> mY1;
+		std::vector<float> mX2;
+		std::vector<float> mY2;
+		std::vector<float> mAreas;
+		std::vector<int> mIndices;
+	};
+	// Settings read by the post processing, copied so the async worker never reads the live members
+	struct mePostprocessParams
+	{
+		float mConfThreshold;
+		float mNMSThreshold;
+		eNMSMode mNMSMode;
+		int mNMSTopK;
+		bool mbSoftNMS;
+		float mSoftNMSSigma;
+	};
+	// Buffers reused by the post processing. The calling thread uses mScratch, the async worker owns its own
+	struct mePostprocessScratch
+	{
+		meCandidateBuffer mCandidates;
+		std::vector<std::pair<float, int>> mNMSScoreIndices;
+		std::vector<meKeptBoxes> mNMSKeptBoxes;
+	};
+	mePostprocessScratch mScratch;
+
+	cv::Mat mTrackGrayFull;
+	cv::Mat mTrackCurrGray;     // downsampled gray of the current frame
+	cv::Mat mTrackPrevGray;     // downsampled gray of the previous frame
+	cv::Mat mTrackKeyGray;      // downsampled gray of the last YOLO frame
+	cv::Mat mTrackDiff;
+	cv::Mat mTrackScores;
+	int mFramesSinceDetection = 0;
+	int mDetectedFrameCount = 0;
+	int mTrackedFrameCount = 0;
+	bool mbLastFrameDetected = false;
+
+	enum eAsyncSlotState { SLOT_Free = 0, SLOT_Filling = 1, SLOT_Pending = 2, SLOT_Running = 3 };
+	struct meAsyncSlot
+	{
+		cv::Mat mBlob;
+		cv::Size mFrameSize;
+		int mFrameId = -1;
+		eAsyncSlotState mState = SLOT_Free;
+		std::vector<std::string> mOutputNames; // Snapshot taken at SubmitFrame
+		mePostprocessParams mParams;           // Snapshot taken at SubmitFrame
+		std::chrono::high_resolution_clock::time_point mSubmitTime;
+	};
+	struct meAsyncState
+	{
+		std::thread mThread;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		std::condition_variable mIdleCondition; // Signalled whenever the worker frees a slot
+		bool mbStopRequested = false;
+		meAsyncSlot mSlots[2];
+		std::deque<AsyncResult> mResults;
+		int mNextFrameId = 0;
+		int mDroppedFrameCount = 0;
+		~meAsyncState();
+	};
+	struct meSwapState
+	{
+		std::thread mThread;
+		std::mutex mMutex;
+		bool mbLoading = false;
+		std::shared_ptr<YOLO_v3_DNN> mReadyModel; // Loaded and warmed up, waiting for SwapModelIfReady
+		~meSwapState();
+	};
+	// Created in StartModelSwap, held by pointer since thread/mutex are not copyable
+	std::shared_ptr<meSwapState> mSwap;
+
+	// Created in StartAsyncInference, held by pointer since thread/mutex are not copyable
+	std::shared_ptr<meAsyncState> mAsync;
 
 
 	void drawPred(const int& classId, const float& conf,const cv::Rect& box, cv::Mat* currFrame);
 	std::vector<std::string> mGetOutputsNames(const cv::dnn::Net& net);
+	void reopenDiskCache();
+	void waitAsyncIdle();
+	bool setLoadedNet(const cv::dnn::Net& net, const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights);
 
+	void doPreprocessFrame(const cv::Mat& frame, cv::Mat* blob);
 	void doPostprocessFrame(cv::Mat* currFrame);
-	void doConfidenceProcess(cv::Mat* currFrame);
-	void doNMSProcess();
+	mePostprocessParams makePostprocessParams();
+	void doConfidenceProcess(const std::vector<cv::Mat>& outs, const cv::Size& frameSize, DetectionResult* detection);
+	void doConfidenceProcess(const std::vector<cv::Mat>& outs, const cv::Size& frameSize, const mePostprocessParams& params,
+		mePostprocessScratch* scratch, DetectionResult* detection);
+	void doConfidenceProcess_MinMaxLoc(const std::vector<cv::Mat>& outs, const cv::Size& frameSize, DetectionResult* detection);
+	int decodeOutputRows(const cv::Mat& out, const cv::Size& frameSize, const float& confThreshold, meCandidateBuffer* candidates, const int& startCount);
+	void doNMSProcess(DetectionResult* detection);
+	void doNMSProcess(const mePostprocessParams& params, mePostprocessScratch* scratch, DetectionResult* detection);
+	void doNMSProcess_OpenCV(DetectionResult* detection);
+	void doSoftNMSProcess(const mePostprocessParams& params, mePostprocessScratch* scratch, DetectionResult* detection);
+	bool isSuppressedByKept(const meKeptBoxes& kept, const cv::Rect& box, const std::vector<cv::Rect>& boxes, const float& nmsThreshold);
+	void asyncInferenceLoop(meAsyncState* asyncState);
+	std::vector<cv::Rect> makeTileRects(const cv::Size& frameSize);
+	bool isSceneChanged(const cv::Mat& currGray);
+	void doTrackBoxes(const cv::Mat& prevGray, const cv::Mat& currGray, DetectionResult* detection);
+	void doTileMergeProcess(const std::vector<cv::Rect>& tileRects, const std::vector<DetectionResult>& tileDetections, DetectionResult* detection);
 	void drawFrameTime(cv::Mat* currFrame);
+	void recordLayerTimings();
 public:
+	// Not copyable: the async and swap threads are bound to this instance
+	YOLO_v3_DNN(const YOLO_v3_DNN&) = delete;
+	YOLO_v3_DNN& operator=(const YOLO_v3_DNN&) = delete;
 	YOLO_v3_DNN(const float& confThreshold = 0.2,const float& nmsThreshold = 0.4,const int& inpWidth = 416,const int& inpHeight = 416);
-	void MakeYOLONetFromFile(const std::string& classesFile, const std::string& modelConfiguration,const std::string& modelWeights);
+	void MakeYOLONetFromFile(const std::string& classesFile, const std::string& modelConfiguration,const std::string& modelWeights, const bool& isWarmUp = false);
+	bool MakeQuantizedYOLONetFromFile(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights,
+		const std::vector<cv::Mat>& calibrationFrames);
+	bool MakeYOLONetFromMemory(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights,
+		const char* cfgBuffer, const size_t& cfgSize, const char* weightsBuffer, const size_t& weightsSize);
+	bool IsQuantized();
+	bool WarmUp();
+	StartupProfile GetStartupProfile();
+	bool GetMemoryConsumption(size_t* weightsBytes, size_t* blobsBytes);
 	void PassThroughWithPostProcessing(const cv::Mat& currFrame, cv::Mat* detectedFrame);
 	bool PassThrough(cv::Mat* currFrame);
+	bool PassThrough(const cv::Mat& currFrame, DetectionResult* detection);
+	bool PassThrough(cv::Mat* currFrame, const std::string& cacheKey);
+	void ClearOutputCache();
+	bool EnableDiskCache(const std::string& cacheFolder);
+	void DisableDiskCache();
+	bool PassThroughBatch(const std::vector<cv::Mat>& frames, std::vector<DetectionResult>* detections);
+	bool PassThroughTiled(cv::Mat* currFrame);
+	bool PassThroughTracked(cv::Mat* currFrame);
+	void ResetTracking();
+	bool IsLastFrameDetected();
+	float GetYOLODutyCycle();
 	int GetObjectRects(InBoxChecker* inBoxChecker);
+	int GetObjectRects(const DetectionResult& detection, InBoxChecker* inBoxChecker);
 	void DrawBoxes(cv::Mat* currFrame, const bool& isDrawFrameTime = true);
 
 	bool SetConfidenceThreshold(const float& confidenceThreshold);
 	bool SetNMSThreshold(const float& NMSThreshold);
+	bool SetBatchSize(const int& batchSize);
+	bool SetInputSize(const int& inpWidth, const int& inpHeight);
+	cv::Size GetInputSize();
+	bool SetTileOverlap(const int& tileOverlap);
+	bool SetOutputHeads(const int& outputHeads);
+	bool SetTrackingInterval(const int& trackingInterval);
+	bool SetSceneChangeThreshold(const float& sceneChangeThreshold);
+	int GetTileCount(const cv::Size& frameSize);
+
+	void DecodeOutputs(const std::vector<cv::Mat>& outs, const cv::Size& frameSize, DetectionResult* detection, const bool& isMinMaxLocKernel = false);
+	std::vector<cv::Mat> GetRawOutputs();
+	void PreprocessFrame(const cv::Mat& currFrame, cv::Mat* blob);
+	int GetPreprocessReallocCount();
+
+	bool SetNMSMode(const eNMSMode& nmsMode);
+	bool SetNMSTopK(const int& topK);
+	bool SetSoftNMS(const bool& isSoftNMS, const float& sigma = 0.5f);
+	void RunNMS(DetectionResult* detection, const bool& isOpenCVNMS = false);
+
+	bool StartAsyncInference();
+	void StopAsyncInference();
+	int SubmitFrame(const cv::Mat& currFrame);
+	bool TryGetResult(AsyncResult* result);
+	int GetDroppedFrameCount();
+
+	bool StartModelSwap(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights);
+	bool IsModelSwapPending();
+	bool SwapModelIfReady();
+
+	bool StartLayerProfiling(const int& frameWindow = 100);
+	void StopLayerProfiling();
+	InferenceProfile GetInferenceProfile();
+	bool SaveInferenceProfileCSV(const std::string& path);
+	bool SaveInferenceProfileJSON(const std::string& path);
 };
 
 //
@@ -70,14 +310,45 @@ YOLO_v3_DNN::YOLO_v3_DNN(const float& confThreshold,const float& nmsThreshold,co
 }
 
 //θ ޾Ƽ Ʈũ .
-void YOLO_v3_DNN::MakeYOLONetFromFile(const std::string& classesFile, const std::string& modelConfiguration,const std::string& modelWeights)
+//cfg, weights ޸ ؼ ۷ ѱǷ  ѹ   ʴ´.  ȵǸ η д´.
+//isWarmUp̸   forward ̸  ù  ̾ Ҵ ð  ʰ Ѵ.
+void YOLO_v3_DNN::MakeYOLONetFromFile(const std::string& classesFile, const std::string& modelConfiguration,const std::string& modelWeights,
+	const bool& isWarmUp)
 {
+	//񵿱  ߷ 尡  Ʈũ   ٸ
+	waitAsyncIdle();
+
 	//dnn network settings for object detection
 	std::ifstream ifs(classesFile.c_str());
 	std::string line;
 	while (getline(ifs, line)) mClasses.push_back(line);
 
-	mNeuralNet = cv::dnn::readNetFromDarknet(modelConfiguration, modelWeights);
+	mModelConfiguration = modelConfiguration;
+	mModelWeights = modelWeights;
+	mStartupProfile = {};
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	MappedFile cfgFile;
+	MappedFile weightsFile;
+	if (cfgFile.Open(modelConfiguration) && weightsFile.Open(modelWeights))
+	{
+		mNeuralNet = cv::dnn::readNetFromDarknet(cfgFile.GetData(), cfgFile.GetSize(), weightsFile.GetData(), weightsFile.GetSize());
+	}
+	else
+	{
+		mNeuralNet = cv::dnn::readNetFromDarknet(modelConfiguration, modelWeights);
+	}
+	//ġ Ʈũ  ǾǷ  ٷ ݴ´
+	cfgFile.Close();
+	weightsFile.Close();
+	auto endTime = std::chrono::high_resolution_clock::now();
+	mStartupProfile.ParseTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / 1000.0;
+	mStartupProfile.TotalTime = mStartupProfile.ParseTime;
+
+	//ص °   ̹Ƿ 
+	mOutputNames.clear();
+	ClearOutputCache();
+	mbQuantized = false;
 
 	if (mNeuralNet.empty())
 	{
@@ -91,6 +362,157 @@ void YOLO_v3_DNN::MakeYOLONetFromFile(const std::string& classesFile, const std:
 
 	mNeuralNet.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
 	mNeuralNet.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+
+	// ̸ ߷ 尡   ̸ صд. SubmitFrame Ʈũ ǵ帮 ʰ 縸 Ѵ
+	mGetOutputsNames(mNeuralNet);
+	reopenDiskCache();
+
+	if (isWarmUp)
+	{
+		WarmUp();
+	}
+}
+
+//float    calibrationFrames Ȱ  Ƽ INT8 Ʈũ ٲ۴.
+// float ״ζ ó float 𵨰 . ȭ ϸ float 𵨷  false ش.
+//Net::quantize OpenCV 4.6 Ƿ, Ʈ ⺻ 4.0.1 ϸ ȭ κ  ׻ false ش.
+bool YOLO_v3_DNN::MakeQuantizedYOLONetFromFile(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights,
+	const std::vector<cv::Mat>& calibrationFrames)
+{
+	MakeYOLONetFromFile(classesFile, modelConfiguration, modelWeights);
+
+	if (calibrationFrames.empty())
+	{
+		std::cerr << "no calibration frames for quantization!" << std::endl;
+		return false;
+	}
+
+#if (CV_VERSION_MAJOR > 4) || ((CV_VERSION_MAJOR == 4) && (CV_VERSION_MINOR >= 6))
+	cv::Mat calibrationBlob = cv::dnn::blobFromImages(calibrationFrames, 1 / 255.0, cv::Size(mInpWidth, mInpHeight), cv::Scalar(0, 0, 0), true, false);
+
+	try
+	{
+		mNeuralNet = mNeuralNet.quantize(calibrationBlob, CV_32F, CV_32F);
+	}
+	catch (const cv::Exception& e)
+	{
+		std::cerr << "Can't quantize the dnn net : " << e.what() << std::endl;
+		return false;
+	}
+
+	mNeuralNet.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+	mNeuralNet.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+
+	mOutputNames.clear();
+	mGetOutputsNames(mNeuralNet);
+	ClearOutputCache();
+	mbQuantized = true;
+
+	return true;
+#else
+	std::cerr << "INT8 quantization needs OpenCV 4.6 or later, current version is " << CV_VERSION << std::endl;
+	std::cerr << "keep using the float model" << std::endl;
+	return false;
+#endif
+}
+
+//̹ ޸𸮿 о cfg, weights Ʈũ .  Ǯ  ѹ а   鶧 .
+// δ ũ ĳ Ű 鶧 Ƿ  ޴´.
+bool YOLO_v3_DNN::MakeYOLONetFromMemory(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights,
+	const char* cfgBuffer, const size_t& cfgSize, const char* weightsBuffer, const size_t& weightsSize)
+{
+	return setLoadedNet(cv::dnn::readNetFromDarknet(cfgBuffer, cfgSize, weightsBuffer, weightsSize), classesFile, modelConfiguration, modelWeights);
+}
+
+//о Ʈũ Ŭ    𵨷 ´. MakeYOLONetFromMemory  ü 尡  .
+//Ʈũ (б ) false
+bool YOLO_v3_DNN::setLoadedNet(const cv::dnn::Net& net, const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights)
+{
+	waitAsyncIdle();
+
+	std::ifstream ifs(classesFile.c_str());
+	std::string line;
+	mClasses.clear();
+	while (getline(ifs, line)) mClasses.push_back(line);
+
+	mModelConfiguration = modelConfiguration;
+	mModelWeights = modelWeights;
+	mNeuralNet = net;
+	mOutputNames.clear();
+	ClearOutputCache();
+	mbQuantized = false;
+
+	if (mNeuralNet.empty())
+	{
+		std::cerr << "Can't load network by using the following files: " << std::endl;
+		std::cerr << "cfg-file:     " << modelConfiguration << std::endl;
+		std::cerr << "weights-file: " << modelWeights << std::endl;
+		return false;
+	}
+
+	mNeuralNet.setPreferableBackend(cv::dnn::DNN_BACKEND_OPENCV);
+	mNeuralNet.setPreferableTarget(cv::dnn::DNN_TARGET_CPU);
+
+	mGetOutputsNames(mNeuralNet);
+	reopenDiskCache();
+
+	return true;
+}
+
+bool YOLO_v3_DNN::IsQuantized()
+{
+	return mbQuantized;
+}
+
+// Է ũ,     ι forward Ѵ.
+//ù° ̾ ʱȭ  Ҵ Ե ð, ι° Ҵ   ð̴.
+//Է ũ⳪  带 ٲٸ ٽ ҴǹǷ ٲ ڿ ٽ ҷ ȴ.
+bool YOLO_v3_DNN::WarmUp()
+{
+	if (mNeuralNet.empty())
+	{
+		return false;
+	}
+
+	int blobShape[] = { 1, 3, mInpHeight, mInpWidth };
+	cv::Mat dummyBlob(4, blobShape, CV_32F, cv::Scalar(0));
+	std::vector<cv::Mat> outs;
+
+	auto startTime = std::chrono::high_resolution_clock::now();
+	mNeuralNet.setInput(dummyBlob);
+	mNeuralNet.forward(outs, mGetOutputsNames(mNeuralNet));
+	auto endTime = std::chrono::high_resolution_clock::now();
+	mStartupProfile.AllocateTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / 1000.0;
+
+	startTime = std::chrono::high_resolution_clock::now();
+	mNeuralNet.setInput(dummyBlob);
+	mNeuralNet.forward(outs, mGetOutputsNames(mNeuralNet));
+	endTime = std::chrono::high_resolution_clock::now();
+	mStartupProfile.WarmUpTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / 1000.0;
+
+	mStartupProfile.TotalTime = mStartupProfile.ParseTime + mStartupProfile.AllocateTime + mStartupProfile.WarmUpTime;
+
+	return true;
+}
+
+//MakeYOLONetFromFile WarmUp   ð(ms)
+YOLO_v3_DNN::StartupProfile YOLO_v3_DNN::GetStartupProfile()
+{
+	return mStartupProfile;
+}
+
+// Է ũ⿡ Ʈũ ġ, ߰  ޸ 뷮(byte)
+bool YOLO_v3_DNN::GetMemoryConsumption(size_t* weightsBytes, size_t* blobsBytes)
+{
+	if (mNeuralNet.empty())
+	{
+		return false;
+	}
+
+	cv::dnn::MatShape inputShape = { 1, 3, mInpHeight, mInpWidth };
+	mNeuralNet.getMemoryConsumption(inputShape, *weightsBytes, *blobsBytes);
+
+	return true;
 }
 
 //Mat ϳ ޾Ƽ Ʈũ Ų ڽ ׸.
@@ -106,13 +528,19 @@ void YOLO_v3_DNN::PassThroughWithPostProcessing(const cv::Mat& currFrame, cv::Ma
 	}
 	else
 	{
-		// ӿ detectedFrame deep copy
-		currFrame.copyTo(detectedFrame_);
+		// ӿ detectedFrame deep copy.  ũ detectedFrame ۸ ״ ,  Mat̸  ʴ´
+		if (detectedFrame_.data != currFrame.data)
+		{
+			currFrame.copyTo(detectedFrame_);
+		}
 
 		//do dnn calculation
-		mBlob = cv::dnn::blobFromImage(currFrame, 1 / 255.0, cv::Size(mInpWidth, mInpHeight), cv::Scalar(0, 0, 0), true, false);
+		doPreprocessFrame(currFrame, &mBlob);
 		mNeuralNet.setInput(mBlob);
+		//mOuts ũ ĳ ε 並 Ű  forward ű⿡ Ϸ ϹǷ 
+		mOuts.clear();
 		mNeuralNet.forward(mOuts, mGetOutputsNames(mNeuralNet));
+		recordLayerTimings();
 
 		//draw boxes and labels
 		doPostprocessFrame(&detectedFrame_);
@@ -130,7 +558,14 @@ void YOLO_v3_DNN::PassThroughWithPostProcessing(const cv::Mat& currFrame, cv::Ma
 //Ʈũ Ű ڽ,ε  .
 bool YOLO_v3_DNN::PassThrough(cv::Mat* currFrame)
 {
-	cv::Mat& currFrame_ = *currFrame;
+	return PassThrough(*currFrame, &mDetection);
+}
+
+//   detection . û  ü  Ƿ  Ǯ  尡  νϽ θ.
+// νϽ  忡 ÿ θ ȵȴ.
+bool YOLO_v3_DNN::PassThrough(const cv::Mat& currFrame, DetectionResult* detection)
+{
+	const cv::Mat& currFrame_ = currFrame;
 
 	if (mNeuralNet.empty())
 	{
@@ -141,188 +576,1842 @@ bool YOLO_v3_DNN::PassThrough(cv::Mat* currFrame)
 	}
 	else
 	{
-		mBlob = cv::dnn::blobFromImage(currFrame_, 1 / 255.0, cv::Size(mInpWidth, mInpHeight), cv::Scalar(0, 0, 0), true, false);
-		mNeuralNet.setInput(mBlob);
-		mNeuralNet.forward(mOuts, mGetOutputsNames(mNeuralNet));
+		//ũ ĳÿ  ,  ̹ °  forward Ѵ
+		//ĳ Ű    Ƿ  带  Ѵ
+		bool isDiskCacheUsable = (mDiskCache != nullptr) && (mOutputHeads == Head_All) && (mbQuantized == false);
+		bool isCached = isDiskCacheUsable && mDiskCache->Load(currFrame_, &mOuts);
+		if (isCached == false)
+		{
+			doPreprocessFrame(currFrame_, &mBlob);
+			mNeuralNet.setInput(mBlob);
+			//  ĳ ̾ mOuts ε б  並 Ų. forward ű⿡  ʰ 
+			mOuts.clear();
+			mNeuralNet.forward(mOuts, mGetOutputsNames(mNeuralNet));
+			recordLayerTimings();
+
+			if (isDiskCacheUsable)
+			{
+				mDiskCache->Store(currFrame_, mOuts);
+			}
+		}
 
-		doConfidenceProcess(&currFrame_);
-		doNMSProcess();
+		doConfidenceProcess(mOuts, currFrame_.size(), detection);
+		doNMSProcess(detection);
 
 		return true;
 	}
 }
 
-//Ȯ ׸. postprocessԼ Ѵ.
-void YOLO_v3_DNN::drawPred(const int& classId, const float& conf, const cv::Rect& box, cv::Mat* currFrame)
+//Ʈũ ° cacheKey صΰ,  Ű ٽ  forward  ó ٽ Ѵ.
+//Ȧ常 ٲ㰡  ̹   迡 Ѵ.
+bool YOLO_v3_DNN::PassThrough(cv::Mat* currFrame, const std::string& cacheKey)
 {
 	cv::Mat& currFrame_ = *currFrame;
 
-	//Draw a rectangle displaying the bounding box
-	cv::rectangle(currFrame_, cv::Point(box.x, box.y), cv::Point(box.x + box.width, box.y + box.height),
-		cv::Scalar(0, 0, 255));
+	auto cached = mOutsCache.find(cacheKey);
+	if (cached != mOutsCache.end())
+	{
+		// ° ۸ ϸ  forward  ۿ Ƿ   
+		const std::vector<cv::Mat>& cachedOuts = cached->second;
+		mOuts.resize(cachedOuts.size());
+		for (size_t i = 0; i < cachedOuts.size(); ++i)
+		{
+			mOuts[i] = cachedOuts[i].clone();
+		}
 
-	//Get the label for the class name and its confidence
-	std::string label = cv::format("%.2f", conf);
-	if (!mClasses.empty())
+		doConfidenceProcess(mOuts, currFrame_.size(), &mDetection);
+		doNMSProcess(&mDetection);
+
+		return true;
+	}
+
+	if (PassThrough(&currFrame_) == false)
 	{
-		CV_Assert(classId < (int)mClasses.size());
-		label = mClasses[classId] + ":" + label;
+		return false;
 	}
 
-	//Display the label at the top of the bounding box
-	int baseLine;
-	cv::Size labelSize = getTextSize(label, cv::FONT_HERSHEY_SIMPLEX, 0.5, 1, &baseLine);
-	int put_y = cv::max(box.y, labelSize.height);
-	cv::putText(currFrame_, label, cv::Point(box.x, put_y), cv::FONT_HERSHEY_SIMPLEX, 0.75, cv::Scalar(255, 0, 0), 2);
+	//Ʈũ  ۸   Ƿ   
+	std::vector<cv::Mat>& newOuts = mOutsCache[cacheKey];
+	newOuts.resize(mOuts.size());
+	for (size_t i = 0; i < mOuts.size(); ++i)
+	{
+		newOuts[i] = mOuts[i].clone();
+	}
+
+	return true;
 }
 
-//Net ƿǲ ̾   Լ. Net ̹ ų Ѵ.
-std::vector<std::string> YOLO_v3_DNN::mGetOutputsNames(const cv::dnn::Net& net)
+//ص Ʈũ °  
+void YOLO_v3_DNN::ClearOutputCache()
+{
+	mOutsCache.clear();
+}
+
+//Ʈũ ° ũ صΰ  ට Ѵ.
+//ĳ Ű cfg, weights   Է ũ, ̹  ؽ̴. Ʈũ  ڿ ȣؾ Ѵ.
+bool YOLO_v3_DNN::EnableDiskCache(const std::string& cacheFolder)
 {
-	static std::vector<std::string> names;
-	if (names.empty())
+	if (mNeuralNet.empty())
 	{
-		//Get the indices of the output layers, i.e. the layers with unconnected outputs
-		std::vector<int> outLayers = net.getUnconnectedOutLayers();
+		std::cerr << "Can't load the dnn net internally!" << std::endl;
+		std::cerr << "make a proper net before enabling the disk cache" << std::endl;
+		return false;
+	}
 
-		//get the names of all the layers in the network
-		std::vector<std::string> layersNames = net.getLayerNames();
+	//ε ° Ű   Ƿ 
+	mOuts.clear();
 
-		// Get the names of the output layers in names
-		names.resize(outLayers.size());
-		for (size_t i = 0; i < outLayers.size(); ++i)
-			names[i] = layersNames[outLayers[i] - 1];
-	}
-	return names;
+	mDiskCache = std::make_shared<DNNOutputCache>();
+	return mDiskCache->Open(cacheFolder, mModelConfiguration, mModelWeights, mInpWidth, mInpHeight);
 }
 
-//  ڽ ġ Լ
-void YOLO_v3_DNN::doPostprocessFrame(cv::Mat* currFrame)
+//ũ ĳð    cfg, weights  ؽø ٽ .  Ʈũ  ڿ θ.
+//ٸ  Ʈ Ű ޶  ̻  ʴ´
+void YOLO_v3_DNN::reopenDiskCache()
 {
-	cv::Mat& currFrame_ = *currFrame;
+	if (mDiskCache == nullptr)
+	{
+		return;
+	}
 
-	doConfidenceProcess(&currFrame_);
-	doNMSProcess();
-	DrawBoxes(&currFrame_);
+	//ε ° Ű   Ƿ 
+	mOuts.clear();
+	mDiskCache->Open(mDiskCache->GetCacheFolder(), mModelConfiguration, mModelWeights, mInpWidth, mInpHeight);
 }
 
-//ŷڵ  ؼ ڽ İ
-void YOLO_v3_DNN::doConfidenceProcess(cv::Mat* currFrame)
+//ũ ĳø 
+void YOLO_v3_DNN::DisableDiskCache()
 {
-	cv::Mat& currFrame_ = *currFrame;
+	mOuts.clear();
+	mDiskCache.reset();
+}
 
-	mClassIds.clear();
-	mConfidences.clear();
-	mBoxes.clear();
+//  Mat ġ   Ʈũ ѹ Ű, ̹   .
+//  ̹ PassThrough Ͱ .
+bool YOLO_v3_DNN::PassThroughBatch(const std::vector<cv::Mat>& frames, std::vector<DetectionResult>* detections)
+{
+	auto& detections_ = *detections;
 
-	for (size_t i = 0; i < mOuts.size(); ++i)
+	if (mNeuralNet.empty())
 	{
-		// Scan through all the bounding boxes output from the network and keep only the
-		// ones with high confidence scores. Assign the box's class label as the class
-		// with the highest score for the box.
-		float* data = (float*)mOuts[i].data;
-		cv::Mat scores;
+		std::cerr << "Can't load the dnn net internally!" << std::endl;
+		std::cerr << "make a proper net before use this function" << std::endl;
+		std::cerr << "make a proper net with right filestring please" << std::endl;
+		return false;
+	}
+
+	detections_.clear();
+	detections_.resize(frames.size());
 
-		for (int j = 0; j < mOuts[i].rows; ++j, data += mOuts[i].cols)
+	std::vector<cv::Mat> batchFrames;
+	std::vector<cv::Mat> imageOuts;
+
+	for (size_t start = 0; start < frames.size(); start += mBatchSize)
+	{
+		size_t end = std::min(start + (size_t)mBatchSize, frames.size());
+		int batchCount = (int)(end - start);
+
+		batchFrames.assign(frames.begin() + start, frames.begin() + end);
+
+		//NCHW  ϳ  forward ѹ 
+		mBlob = cv::dnn::blobFromImages(batchFrames, 1 / 255.0, cv::Size(mInpWidth, mInpHeight), cv::Scalar(0, 0, 0), true, false);
+		mNeuralNet.setInput(mBlob);
+		mOuts.clear();
+		mNeuralNet.forward(mOuts, mGetOutputsNames(mNeuralNet));
+		recordLayerTimings();
+
+		//  带 ̹ ٽ ߶󳽴
+		for (int b = 0; b < batchCount; b++)
 		{
-			scores = mOuts[i].row(j).colRange(5, mOuts[i].cols);
-			cv::Point classIdPoint;
-			double confidence;
-			// Get the value and location of the maximum score
-			minMaxLoc(scores, 0, &confidence, 0, &classIdPoint);
-			if (confidence > mConfThreshold)
+			imageOuts.resize(mOuts.size());
+			for (size_t i = 0; i < mOuts.size(); ++i)
 			{
-				int centerX = (int)(data[0] * currFrame_.cols);
-				int centerY = (int)(data[1] * currFrame_.rows);
-				int width = (int)(data[2] * currFrame_.cols);
-				int height = (int)(data[3] * currFrame_.rows);
-				int left = centerX - width / 2;
-				int top = centerY - height / 2;
-
-				mClassIds.push_back(classIdPoint.x);
-				mConfidences.push_back((float)confidence);
-				mBoxes.push_back(cv::Rect(left, top, width, height));
+				if (mOuts[i].dims == 3)
+				{
+					//ġ 2 ̸̻  [batch, rows, cols] · ´
+					imageOuts[i] = cv::Mat(mOuts[i].size[1], mOuts[i].size[2], CV_32F, mOuts[i].ptr<float>(b));
+				}
+				else
+				{
+					int rowsPerImage = mOuts[i].rows / batchCount;
+					imageOuts[i] = mOuts[i].rowRange(b * rowsPerImage, (b + 1) * rowsPerImage);
+				}
 			}
+
+			doConfidenceProcess(imageOuts, batchFrames[b].size(), &detections_[start + b]);
+			doNMSProcess(&detections_[start + b]);
 		}
 	}
+
+	return true;
 }
 
-//   NMS ˰ ģ.
-//indices ִ ε ¥ Rectν ٲ.
-void YOLO_v3_DNN::doNMSProcess()
+// ȸ    ٿ 
+static const int TRACK_DOWNSAMPLE = 2;
+//    ڽ ֺ ̸ŭ  ã´
+static const int TRACK_SEARCH_MARGIN = 16;
+//   ø ּ ũ
+static const int TRACK_MIN_TEMPLATE = 4;
+//̺   ģ  
+static const double TRACK_MIN_SCORE = 0.5;
+
+// . mTrackingInterval Ӹ, Ǵ   Ӱ   ޶ θ .
+//    ڽ ø Ī ű.  PassThrough  ο ǹǷ GetObjectRects, DrawBoxes ״ .
+bool YOLO_v3_DNN::PassThroughTracked(cv::Mat* currFrame)
 {
-	// Perform non maximum suppression to eliminate redundant overlapping boxes with
-	// lower confidences
-	mIndices.clear();
-	cv::dnn::NMSBoxes(mBoxes, mConfidences, mConfThreshold, mNMSThreshold, mIndices);
+	cv::Mat& currFrame_ = *currFrame;
 
-}
+	cv::cvtColor(currFrame_, mTrackGrayFull, cv::COLOR_BGR2GRAY);
+	cv::resize(mTrackGrayFull, mTrackCurrGray, cv::Size(), 1.0 / TRACK_DOWNSAMPLE, 1.0 / TRACK_DOWNSAMPLE, cv::INTER_AREA);
 
-//ο  Rect ̾ƿ´
-int YOLO_v3_DNN::GetObjectRects(InBoxChecker* inBoxChecker)
-{
-	InBoxChecker& inBoxChecker_ = *inBoxChecker;
+	bool isDetectionFrame = mTrackKeyGray.empty() || (mTrackKeyGray.size() != mTrackCurrGray.size())
+		|| (mFramesSinceDetection + 1 >= mTrackingInterval) || isSceneChanged(mTrackCurrGray);
 
-	int classId;
-	std::string label;
-	for (size_t i = 0; i < mIndices.size(); ++i)
+	if (isDetectionFrame)
 	{
-		classId = mClassIds[mIndices[i]];
-		CV_Assert(classId < (int)mClasses.size());
-		label = mClasses[classId];
+		if (PassThrough(&currFrame_) == false)
+		{
+			return false;
+		}
 
-		inBoxChecker_.AddBox(mBoxes[mIndices[i]], InBoxChecker::YOLOv3, label);
+		mTrackedDetection = mDetection;
+		mTrackCurrGray.copyTo(mTrackKeyGray);
+		mFramesSinceDetection = 0;
+		mDetectedFrameCount++;
+	}
+	else
+	{
+		doTrackBoxes(mTrackPrevGray, mTrackCurrGray, &mTrackedDetection);
+		mDetection = mTrackedDetection;
+		mFramesSinceDetection++;
+		mTrackedFrameCount++;
 	}
+
+	//      ȴ. ۴ ٲ㰡 
+	cv::swap(mTrackPrevGray, mTrackCurrGray);
+	mbLastFrameDetected = isDetectionFrame;
+
+	return true;
 }
 
-//ο  Rect ̿ؼ ڽ ׸.
-void YOLO_v3_DNN::DrawBoxes(cv::Mat* currFrame,const bool& isDrawFrameTime) 
+// ¸ .  PassThroughTracked κ 
+void YOLO_v3_DNN::ResetTracking()
 {
-	for (size_t i = 0; i < mIndices.size(); ++i)
-	{
-		int idx = mIndices[i];
-		cv::Rect box = mBoxes[idx];
-		drawPred(mClassIds[idx], mConfidences[idx], box, currFrame);
-	}
+	mTrackKeyGray.release();
+	mTrackPrevGray.release();
+	mTrackedDetection = DetectionResult();
+	mFramesSinceDetection = 0;
+	mDetectedFrameCount = 0;
+	mTrackedFrameCount = 0;
+	mbLastFrameDetected = false;
+}
 
-	if (isDrawFrameTime)
-	{
-		drawFrameTime(currFrame);
-	}
+// PassThroughTracked θ ȴ
+bool YOLO_v3_DNN::IsLastFrameDetected()
+{
+	return mbLastFrameDetected;
 }
 
-//   Ÿ 
-void YOLO_v3_DNN::drawFrameTime(cv::Mat* currFrame)
+// 忡 θ   
+float YOLO_v3_DNN::GetYOLODutyCycle()
 {
-	std::vector<double> layersTimes;
-	double freq = cv::getTickFrequency() / 1000;
-	double t = mNeuralNet.getPerfProfile(layersTimes) / freq;
-	std::string label = cv::format("Inference time for a frame : %.2f ms", t);
-	cv::putText(*currFrame, label, cv::Point(0, 15), cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(0, 0, 255));
+	int totalCount = mDetectedFrameCount + mTrackedFrameCount;
+	return (totalCount > 0) ? ((float)mDetectedFrameCount / totalCount) : 0.0f;
 }
 
-bool YOLO_v3_DNN::SetConfidenceThreshold(const float& confidenceThreshold)
+//  Ӱ   ̷  ȯ ǴѴ
+bool YOLO_v3_DNN::isSceneChanged(const cv::Mat& currGray)
 {
-	if ((0.0f <= confidenceThreshold) && (confidenceThreshold <= 1.0f))
-	{
-		mConfThreshold = confidenceThreshold;
-		return true;
-	}
-	else
-	{
-		return false;
-	}
+	cv::absdiff(currGray, mTrackKeyGray, mTrackDiff);
+	return cv::mean(mTrackDiff)[0] > mSceneChangeThreshold;
 }
 
-bool YOLO_v3_DNN::SetNMSThreshold(const float& NMSThreshold)
+//  ڽ  ø   ֺ ãƼ ڽ ű.
+//ڽ ʹ ۰ų   ģ   ڽ ״ д.
+void YOLO_v3_DNN::doTrackBoxes(const cv::Mat& prevGray, const cv::Mat& currGray, DetectionResult* detection)
 {
-	if ((0.0f <= NMSThreshold) && (NMSThreshold <= 1.0f))
+	auto& detection_ = *detection;
+	cv::Rect grayRect(0, 0, currGray.cols, currGray.rows);
+
+	for (size_t i = 0; i < detection_.Indices.size(); ++i)
 	{
-		mNMSThreshold = NMSThreshold;
-		return true;
-	}
+		cv::Rect& box = detection_.Boxes[detection_.Indices[i]];
+
+		cv::Rect templateRect = cv::Rect(box.x / TRACK_DOWNSAMPLE, box.y / TRACK_DOWNSAMPLE,
+			box.width / TRACK_DOWNSAMPLE, box.height / TRACK_DOWNSAMPLE) & grayRect;
+		if ((templateRect.width < TRACK_MIN_TEMPLATE) || (templateRect.height < TRACK_MIN_TEMPLATE))
+		{
+			continue;
+		}
+
+		cv::Rect searchRect = cv::Rect(templateRect.x - TRACK_SEARCH_MARGIN, templateRect.y - TRACK_SEARCH_MARGIN,
+			templateRect.width + TRACK_SEARCH_MARGIN * 2, templateRect.height + TRACK_SEARCH_MARGIN * 2) & grayRect;
+
+		cv::matchTemplate(currGray(searchRect), prevGray(templateRect), mTrackScores, cv::TM_CCOEFF_NORMED);
+
+		double maxScore;
+		cv::Point maxLoc;
+		cv::minMaxLoc(mTrackScores, NULL, &maxScore, NULL, &maxLoc);
+		if (maxScore < TRACK_MIN_SCORE)
+		{
+			continue;
+		}
+
+		box.x += (searchRect.x + maxLoc.x - templateRect.x) * TRACK_DOWNSAMPLE;
+		box.y += (searchRect.y + maxLoc.y - templateRect.y) * TRACK_DOWNSAMPLE;
+	}
+}
+
+//Ʈũ Է ũ ġ Ÿϵ ū  ߶   ġ Ų.
+//ŸϺ ڽ  ǥ ű  Ÿ 迡 ߸ ڽ ģ.  PassThrough  ο ȴ.
+bool YOLO_v3_DNN::PassThroughTiled(cv::Mat* currFrame)
+{
+	cv::Mat& currFrame_ = *currFrame;
+
+	std::vector<cv::Rect> tileRects = makeTileRects(currFrame_.size());
+	std::vector<cv::Mat> tiles;
+	tiles.reserve(tileRects.size());
+	for (size_t i = 0; i < tileRects.size(); ++i)
+	{
+		//ROI  Ͼ ʴ´
+		tiles.push_back(currFrame_(tileRects[i]));
+	}
+
+	std::vector<DetectionResult> tileDetections;
+	if (PassThroughBatch(tiles, &tileDetections) == false)
+	{
+		return false;
+	}
+
+	doTileMergeProcess(tileRects, tileDetections, &mDetection);
+
+	return true;
+}
+
+//  Ÿϵ ġ .  Ÿ   缭 ħ   Ŀ  ִ.
+// Ʈũ Էº   Ÿ ϳ ´.
+std::vector<cv::Rect> YOLO_v3_DNN::makeTileRects(const cv::Size& frameSize)
+{
+	std::vector<int> xStarts;
+	std::vector<int> yStarts;
+	int tileWidth = std::min(mInpWidth, frameSize.width);
+	int tileHeight = std::min(mInpHeight, frameSize.height);
+
+	for (int axis = 0; axis < 2; axis++)
+	{
+		std::vector<int>& starts = (axis == 0) ? xStarts : yStarts;
+		int frameLength = (axis == 0) ? frameSize.width : frameSize.height;
+		int tileLength = (axis == 0) ? tileWidth : tileHeight;
+		int stride = std::max(1, tileLength - mTileOverlap);
+
+		int pos = 0;
+		while (true)
+		{
+			starts.push_back(pos);
+			if (pos + tileLength >= frameLength)
+			{
+				break;
+			}
+			pos = std::min(pos + stride, frameLength - tileLength);
+		}
+	}
+
+	std::vector<cv::Rect> tileRects;
+	tileRects.reserve(xStarts.size() * yStarts.size());
+	for (size_t y = 0; y < yStarts.size(); ++y)
+	{
+		for (size_t x = 0; x < xStarts.size(); ++x)
+		{
+			tileRects.push_back(cv::Rect(xStarts[x], yStarts[y], tileWidth, tileHeight));
+		}
+	}
+
+	return tileRects;
+}
+
+//Ÿ  ( 谡 ƴ ) ̸ŭ پ  ߸ ڽ 
+static const int TILE_EDGE_MARGIN = 2;
+
+//ŸϺ   ǥ ű Ÿ  ߺ .
+// ü  ŸϿ   IoU , 迡 ߸ ڽ     ħ ãƼ ģ.
+void YOLO_v3_DNN::doTileMergeProcess(const std::vector<cv::Rect>& tileRects, const std::vector<DetectionResult>& tileDetections, DetectionResult* detection)
+{
+	auto& detection_ = *detection;
+
+	std::vector<int> classIds;
+	std::vector<float> confidences;
+	std::vector<cv::Rect> boxes;
+	std::vector<char> isCuts;
+
+	cv::Rect frameRect;
+	for (size_t t = 0; t < tileRects.size(); ++t)
+	{
+		frameRect |= tileRects[t];
+	}
+
+	for (size_t t = 0; t < tileRects.size(); ++t)
+	{
+		const cv::Rect& tile = tileRects[t];
+		const DetectionResult& tileDetection = tileDetections[t];
+		cv::Rect tileArea(0, 0, tile.width, tile.height);
+
+		for (size_t i = 0; i < tileDetection.Indices.size(); ++i)
+		{
+			int idx = tileDetection.Indices[i];
+			cv::Rect box = tileDetection.Boxes[idx] & tileArea;
+			if (box.area() <= 0)
+			{
+				continue;
+			}
+
+			bool isCut = ((tile.x > frameRect.x) && (box.x <= TILE_EDGE_MARGIN))
+				|| ((tile.y > frameRect.y) && (box.y <= TILE_EDGE_MARGIN))
+				|| ((tile.br().x < frameRect.br().x) && (box.br().x >= tile.width - TILE_EDGE_MARGIN))
+				|| ((tile.br().y < frameRect.br().y) && (box.br().y >= tile.height - TILE_EDGE_MARGIN));
+
+			classIds.push_back(tileDetection.ClassIds[idx]);
+			confidences.push_back(tileDetection.Confidences[idx]);
+			boxes.push_back(box + tile.tl());
+			isCuts.push_back(isCut ? 1 : 0);
+		}
+	}
+
+	// ,   Ÿ 
+	std::vector<int> order(boxes.size());
+	for (size_t i = 0; i < order.size(); ++i) order[i] = (int)i;
+	std::stable_sort(order.begin(), order.end(), [&confidences](const int& a, const int& b)
+	{
+		return confidences[a] > confidences[b];
+	});
+
+	detection_.ClassIds.clear();
+	detection_.Confidences.clear();
+	detection_.Boxes.clear();
+	detection_.Indices.clear();
+	std::vector<char> keptIsCuts;
+
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		int cand = order[i];
+		const cv::Rect& box = boxes[cand];
+		bool isDuplicate = false;
+
+		for (size_t k = 0; k < detection_.Boxes.size(); ++k)
+		{
+			if ((mNMSMode == NMS_PerClass) && (detection_.ClassIds[k] != classIds[cand]))
+			{
+				continue;
+			}
+
+			cv::Rect& kept = detection_.Boxes[k];
+			float inter = (float)(box & kept).area();
+			if (inter <= 0.0f)
+			{
+				continue;
+			}
+
+			float iou = inter / (float)(box.area() + kept.area() - inter);
+			if (iou > mNMSThreshold)
+			{
+				isDuplicate = true;
+				break;
+			}
+
+			if (isCuts[cand] || keptIsCuts[k])
+			{
+				float overlapOfSmaller = inter / (float)std::min(box.area(), kept.area());
+				if (overlapOfSmaller > mNMSThreshold)
+				{
+					//߸  ϳ ڽ ģ.    ( ) 
+					kept |= box;
+					keptIsCuts[k] = 1;
+					isDuplicate = true;
+					break;
+				}
+			}
+		}
+
+		if (isDuplicate == false)
+		{
+			detection_.ClassIds.push_back(classIds[cand]);
+			detection_.Confidences.push_back(confidences[cand]);
+			detection_.Boxes.push_back(box);
+			keptIsCuts.push_back(isCuts[cand]);
+		}
+	}
+
+	detection_.Indices.resize(detection_.Boxes.size());
+	for (size_t i = 0; i < detection_.Indices.size(); ++i)
+	{
+		detection_.Indices[i] = (int)i;
+	}
+}
+
+//Ȯ ׸. postprocessԼ Ѵ.
+void YOLO_v3_DNN::drawPred(const int& classId, const float& conf, const cv::Rect& box, cv::Mat* currFrame)
+{
+	cv::Mat& currFrame_ = *currFrame;
+
+	//Draw a rectangle displaying the bounding box
+	cv::rectangle(currFrame_, cv::Point(box.x, box.y), cv::Point(box.x + box.width, box.y + box.height),
+		cv::Scalar(0, 0, 255));
+
+	//Get the label for the class name and its confidence
+	std::string label = cv::format("%.2f", conf);
+	if (!mClasses.empty())
+	{
+		CV_Assert(classId < (int)mClasses.size());
+		label = mClasses[classId] + ":" + label;
+	}
+
+	//Display the label at the top of the bounding box
+	int baseLine;
+	cv::Size labelSize = getTextSize(label, cv::FONT_HERSHEY_SIMPLEX, 0.5, 1, &baseLine);
+	int put_y = cv::max(box.y, labelSize.height);
+	cv::putText(currFrame_, label, cv::Point(box.x, put_y), cv::FONT_HERSHEY_SIMPLEX, 0.75, cv::Scalar(255, 0, 0), 2);
+}
+
+//Net ƿǲ ̾   Լ. Net ̹ ų Ѵ.
+//forward û  ̾   ڿ ִ ̾ ϹǷ,  带    upsample/conv  ǳʶڴ
+std::vector<std::string> YOLO_v3_DNN::mGetOutputsNames(const cv::dnn::Net& net)
+{
+	if (mOutputNames.empty())
+	{
+		//Get the indices of the output layers, i.e. the layers with unconnected outputs
+		std::vector<int> outLayers = net.getUnconnectedOutLayers();
+
+		//get the names of all the layers in the network
+		std::vector<std::string> layersNames = net.getLayerNames();
+
+		// Get the names of the output layers in names, keep only the selected heads
+		for (size_t i = 0; i < outLayers.size(); ++i)
+		{
+			if ((i >= 3) || (mOutputHeads & (1 << i)))
+			{
+				mOutputNames.push_back(layersNames[outLayers[i] - 1]);
+			}
+		}
+
+		//  ٸ Ʈũ  ϳ   
+		if (mOutputNames.empty())
+		{
+			for (size_t i = 0; i < outLayers.size(); ++i)
+				mOutputNames.push_back(layersNames[outLayers[i] - 1]);
+		}
+	}
+	return mOutputNames;
+}
+
+#if CV_SIMD128
+//8Ʈ ä 16 float ٲٰ  ؼ  鿡 Ѵ
+static inline void storeScaledPlane(const cv::v_uint8x16& src, float* dst, const cv::v_float32x4& scale)
+{
+	cv::v_uint16x8 low16, high16;
+	cv::v_uint32x4 part0, part1, part2, part3;
+	cv::v_expand(src, low16, high16);
+	cv::v_expand(low16, part0, part1);
+	cv::v_expand(high16, part2, part3);
+
+	cv::v_store(dst, cv::v_cvt_f32(cv::v_reinterpret_as_s32(part0)) * scale);
+	cv::v_store(dst + 4, cv::v_cvt_f32(cv::v_reinterpret_as_s32(part1)) * scale);
+	cv::v_store(dst + 8, cv::v_cvt_f32(cv::v_reinterpret_as_s32(part2)) * scale);
+	cv::v_store(dst + 12, cv::v_cvt_f32(cv::v_reinterpret_as_s32(part3)) * scale);
+}
+#endif
+
+//blobFromImage(1/255, swapRB)  NCHW  . Ӱ  ۴ Ӹ ؼ ũⰡ   Ҵ ʴ´.
+// cv::resize ϰ, ä и, RB ȯ, ȭ, NCHW ġ ѹ Ѵ. Է ũ    ǳʶڴ.
+void YOLO_v3_DNN::doPreprocessFrame(const cv::Mat& frame, cv::Mat* blob)
+{
+	cv::Mat& blob_ = *blob;
+
+	if (frame.type() != CV_8UC3)
+	{
+		cv::dnn::blobFromImage(frame, blob_, 1 / 255.0, cv::Size(mInpWidth, mInpHeight), cv::Scalar(0, 0, 0), true, false);
+		mPreprocessReallocCount++;
+		return;
+	}
+
+	//ũⰡ  create  ۸ ״ д.  ּҰ ٲ 
+	const int blobSizes[] = { 1, 3, mInpHeight, mInpWidth };
+	const uchar* oldBlobData = blob_.data;
+	blob_.create(4, blobSizes, CV_32F);
+	if (blob_.data != oldBlobData) mPreprocessReallocCount++;
+
+	const cv::Mat* source = &frame;
+	if ((frame.cols != mInpWidth) || (frame.rows != mInpHeight))
+	{
+		const uchar* oldResizedData = mResizedFrame.data;
+		cv::resize(frame, mResizedFrame, cv::Size(mInpWidth, mInpHeight), 0, 0, cv::INTER_LINEAR);
+		if (mResizedFrame.data != oldResizedData) mPreprocessReallocCount++;
+		source = &mResizedFrame;
+	}
+
+	const int planeSize = mInpWidth * mInpHeight;
+	float* rPlane = blob_.ptr<float>();
+	float* gPlane = rPlane + planeSize;
+	float* bPlane = gPlane + planeSize;
+	const float scale = 1.0f / 255.0f;
+
+	for (int row = 0; row < mInpHeight; row++)
+	{
+		const uchar* src = source->ptr<uchar>(row);
+		int offset = row * mInpWidth;
+		int col = 0;
+#if CV_SIMD128
+		cv::v_float32x4 v_scale = cv::v_setall_f32(scale);
+		for (; col <= mInpWidth - 16; col += 16)
+		{
+			cv::v_uint8x16 b, g, r;
+			cv::v_load_deinterleave(src + col * 3, b, g, r);
+			storeScaledPlane(r, rPlane + offset + col, v_scale);
+			storeScaledPlane(g, gPlane + offset + col, v_scale);
+			storeScaledPlane(b, bPlane + offset + col, v_scale);
+		}
+#endif
+		for (; col < mInpWidth; col++)
+		{
+			bPlane[offset + col] = src[col * 3] * scale;
+			gPlane[offset + col] = src[col * 3 + 1] * scale;
+			rPlane[offset + col] = src[col * 3 + 2] * scale;
+		}
+	}
+}
+
+//  ڽ ġ Լ
+void YOLO_v3_DNN::doPostprocessFrame(cv::Mat* currFrame)
+{
+	cv::Mat& currFrame_ = *currFrame;
+
+	doConfidenceProcess(mOuts, currFrame_.size(), &mDetection);
+	doNMSProcess(&mDetection);
+	DrawBoxes(&currFrame_);
+}
+
+//Ŭ   ִ밪  ġ Ѵ. ִ밪  minMaxLoc   ġ ȯѴ.
+static inline int findMaxScore(const float* scores, const int& count, float* maxScore)
+{
+	int i = 0;
+	float best = -FLT_MAX;
+
+#if CV_SIMD128
+	if (count >= 4)
+	{
+		cv::v_float32x4 vBest = cv::v_load(scores);
+		for (i = 4; i + 4 <= count; i += 4)
+		{
+			vBest = cv::v_max(vBest, cv::v_load(scores + i));
+		}
+		best = cv::v_reduce_max(vBest);
+	}
+#endif
+	for (; i < count; i++)
+	{
+		if (scores[i] > best) best = scores[i];
+	}
+
+	int bestIndex = 0;
+	while ((bestIndex < count - 1) && (scores[bestIndex] != best)) bestIndex++;
+
+	*maxScore = best;
+	return bestIndex;
+}
+
+//  Ȧ NMS  ó Ѵ
+YOLO_v3_DNN::mePostprocessParams YOLO_v3_DNN::makePostprocessParams()
+{
+	mePostprocessParams params;
+	params.mConfThreshold = mConfThreshold;
+	params.mNMSThreshold = mNMSThreshold;
+	params.mNMSMode = mNMSMode;
+	params.mNMSTopK = mNMSTopK;
+	params.mbSoftNMS = mbSoftNMS;
+	params.mSoftNMSSigma = mSoftNMSSigma;
+	return params;
+}
+
+//   ۷ óѴ. θ  ̴
+void YOLO_v3_DNN::doConfidenceProcess(const std::vector<cv::Mat>& outs, const cv::Size& frameSize, DetectionResult* detection)
+{
+	doConfidenceProcess(outs, frameSize, makePostprocessParams(), &mScratch, detection);
+}
+
+//ŷڵ  ؼ ڽ İ
+//Ƴ ĺ ̸ Ƶ ĺ (SoA) ,  ѹ  ű.
+// ۸ ڷθ Ƿ ߷ 尡 ڱ ۷ ҷ  ǵ帮 ʴ´.
+void YOLO_v3_DNN::doConfidenceProcess(const std::vector<cv::Mat>& outs, const cv::Size& frameSize, const mePostprocessParams& params,
+	mePostprocessScratch* scratch, DetectionResult* detection)
+{
+	auto& detection_ = *detection;
+	auto& candidates = scratch->mCandidates;
+
+	//ĺ ۴ ü  ŭ Ƶΰ,  ū    ø
+	int totalRows = 0;
+	for (size_t i = 0; i < outs.size(); ++i)
+	{
+		totalRows += outs[i].rows;
+	}
+	if ((int)candidates.mConfidences.size() < totalRows)
+	{
+		candidates.mClassIds.resize(totalRows);
+		candidates.mConfidences.resize(totalRows);
+		candidates.mLefts.resize(totalRows);
+		candidates.mTops.resize(totalRows);
+		candidates.mWidths.resize(totalRows);
+		candidates.mHeights.resize(totalRows);
+	}
+
+	int count = 0;
+	for (size_t i = 0; i < outs.size(); ++i)
+	{
+		count = decodeOutputRows(outs[i], frameSize, params.mConfThreshold, &candidates, count);
+	}
+
+	detection_.ClassIds.assign(candidates.mClassIds.begin(), candidates.mClassIds.begin() + count);
+	detection_.Confidences.assign(candidates.mConfidences.begin(), candidates.mConfidences.begin() + count);
+	detection_.Boxes.resize(count);
+	for (int k = 0; k < count; k++)
+	{
+		detection_.Boxes[k] = cv::Rect(candidates.mLefts[k], candidates.mTops[k], candidates.mWidths[k], candidates.mHeights[k]);
+	}
+}
+
+//  ϳ Ⱦ Ȧ带 Ѵ  ĺ  startCount ġ ä.
+//ȯ ä  ĺ ̴.
+int YOLO_v3_DNN::decodeOutputRows(const cv::Mat& out, const cv::Size& frameSize, const float& confThreshold, meCandidateBuffer* candidates, const int& startCount)
+{
+	const int classCount = out.cols - 5;
+	int count = startCount;
+
+	int* classIds = candidates->mClassIds.data();
+	float* confidences = candidates->mConfidences.data();
+	int* lefts = candidates->mLefts.data();
+	int* tops = candidates->mTops.data();
+	int* widths = candidates->mWidths.data();
+	int* heights = candidates->mHeights.data();
+
+	for (int j = 0; j < out.rows; ++j)
+	{
+		const float* data = out.ptr<float>(j);
+
+		//Ŭ  objectness * Ŭ Ȯ̹Ƿ objectness(data[4]) Ŭ  .
+		// objectness Ȧ   Ŭ   ʿ  .
+		if (data[4] <= confThreshold) continue;
+
+		float confidence;
+		int classId = findMaxScore(data + 5, classCount, &confidence);
+		if (confidence > confThreshold)
+		{
+			int centerX = (int)(data[0] * frameSize.width);
+			int centerY = (int)(data[1] * frameSize.height);
+			int width = (int)(data[2] * frameSize.width);
+			int height = (int)(data[3] * frameSize.height);
+
+			classIds[count] = classId;
+			confidences[count] = confidence;
+			lefts[count] = centerX - width / 2;
+			tops[count] = centerY - height / 2;
+			widths[count] = width;
+			heights[count] = height;
+			count++;
+		}
+	}
+
+	return count;
+}
+
+//minMaxLoc  ྿  ã  .  Ŀΰ , ӵ 񱳿 ܵд.
+void YOLO_v3_DNN::doConfidenceProcess_MinMaxLoc(const std::vector<cv::Mat>& outs, const cv::Size& frameSize, DetectionResult* detection)
+{
+	auto& detection_ = *detection;
+
+	detection_.ClassIds.clear();
+	detection_.Confidences.clear();
+	detection_.Boxes.clear();
+
+	for (size_t i = 0; i < outs.size(); ++i)
+	{
+		// Scan through all the bounding boxes output from the network and keep only the
+		// ones with high confidence scores. Assign the box's class label as the class
+		// with the highest score for the box.
+		float* data = (float*)outs[i].data;
+		cv::Mat scores;
+
+		for (int j = 0; j < outs[i].rows; ++j, data += outs[i].cols)
+		{
+			scores = outs[i].row(j).colRange(5, outs[i].cols);
+			cv::Point classIdPoint;
+			double confidence;
+			// Get the value and location of the maximum score
+			minMaxLoc(scores, 0, &confidence, 0, &classIdPoint);
+			if (confidence > mConfThreshold)
+			{
+				int centerX = (int)(data[0] * frameSize.width);
+				int centerY = (int)(data[1] * frameSize.height);
+				int width = (int)(data[2] * frameSize.width);
+				int height = (int)(data[3] * frameSize.height);
+				int left = centerX - width / 2;
+				int top = centerY - height / 2;
+
+				detection_.ClassIds.push_back(classIdPoint.x);
+				detection_.Confidences.push_back((float)confidence);
+				detection_.Boxes.push_back(cv::Rect(left, top, width, height));
+			}
+		}
+	}
+}
+
+// float IoU Ȧ忡   ̻   ״ Ѵ
+static const float NMS_IOU_MARGIN = 1e-4f;
+
+//float IoU  ϰ, Ȧ ó̰ų  ȵǴ (NaN) NMSBoxes   ٽ Ѵ.
+//׷  ε cv::dnn::NMSBoxes Ȯ .
+static inline bool isOverlapOver(const float& fastIoU, const float& threshold, const cv::Rect& a, const cv::Rect& b)
+{
+	if (fastIoU > threshold + NMS_IOU_MARGIN) return true;
+	if (fastIoU < threshold - NMS_IOU_MARGIN) return false;
+	return (1.f - (float)cv::jaccardDistance(a, b)) > threshold;
+}
+
+//   ۷ NMS . θ  ̴
+void YOLO_v3_DNN::doNMSProcess(DetectionResult* detection)
+{
+	doNMSProcess(makePostprocessParams(), &mScratch, detection);
+}
+
+//   NMS ˰ ģ.
+//indices ִ ε ¥ Rectν ٲ.
+//⺻ (Ŭ , topK , soft-NMS )  cv::dnn::NMSBoxes .
+void YOLO_v3_DNN::doNMSProcess(const mePostprocessParams& params, mePostprocessScratch* scratch, DetectionResult* detection)
+{
+	auto& detection_ = *detection;
+	auto& scoreIndices = scratch->mNMSScoreIndices;
+	auto& keptBoxes = scratch->mNMSKeptBoxes;
+
+	detection_.Indices.clear();
+
+	if (params.mbSoftNMS)
+	{
+		doSoftNMSProcess(params, scratch, &detection_);
+		return;
+	}
+
+	//  ,      (NMSBoxes )
+	scoreIndices.clear();
+	for (size_t i = 0; i < detection_.Confidences.size(); i++)
+	{
+		if (detection_.Confidences[i] > params.mConfThreshold)
+		{
+			scoreIndices.push_back(std::make_pair(detection_.Confidences[i], (int)i));
+		}
+	}
+	std::stable_sort(scoreIndices.begin(), scoreIndices.end(),
+		[](const std::pair<float, int>& a, const std::pair<float, int>& b) { return a.first > b.first; });
+
+	//Ŭ  Ŭ  ڽ   д
+	int groupCount = 1;
+	if (params.mNMSMode == NMS_PerClass)
+	{
+		for (size_t i = 0; i < detection_.ClassIds.size(); i++)
+		{
+			groupCount = std::max(groupCount, detection_.ClassIds[i] + 1);
+		}
+	}
+	if ((int)keptBoxes.size() < groupCount)
+	{
+		keptBoxes.resize(groupCount);
+	}
+	for (int g = 0; g < groupCount; g++)
+	{
+		meKeptBoxes& kept = keptBoxes[g];
+		kept.mX1.clear();
+		kept.mY1.clear();
+		kept.mX2.clear();
+		kept.mY2.clear();
+		kept.mAreas.clear();
+		kept.mIndices.clear();
+	}
+
+	for (size_t i = 0; i < scoreIndices.size(); i++)
+	{
+		int idx = scoreIndices[i].second;
+		const cv::Rect& box = detection_.Boxes[idx];
+		meKeptBoxes& kept = keptBoxes[(params.mNMSMode == NMS_PerClass) ? detection_.ClassIds[idx] : 0];
+
+		if (isSuppressedByKept(kept, box, detection_.Boxes, params.mNMSThreshold))
+		{
+			continue;
+		}
+
+		kept.mX1.push_back((float)box.x);
+		kept.mY1.push_back((float)box.y);
+		kept.mX2.push_back((float)(box.x + box.width));
+		kept.mY2.push_back((float)(box.y + box.height));
+		kept.mAreas.push_back((float)box.area());
+		kept.mIndices.push_back(idx);
+
+		detection_.Indices.push_back(idx);
+		if ((params.mNMSTopK > 0) && ((int)detection_.Indices.size() >= params.mNMSTopK))
+		{
+			break;
+		}
+	}
+}
+
+//̹  ڽ(SoA) IoU 4 SIMD ؼ, ϳ Ȧ带  true
+bool YOLO_v3_DNN::isSuppressedByKept(const meKeptBoxes& kept, const cv::Rect& box, const std::vector<cv::Rect>& boxes, const float& nmsThreshold)
+{
+	const float x1 = (float)box.x;
+	const float y1 = (float)box.y;
+	const float x2 = (float)(box.x + box.width);
+	const float y2 = (float)(box.y + box.height);
+	const float area = (float)box.area();
+	const int keptCount = (int)kept.mIndices.size();
+
+	int k = 0;
+
+#if CV_SIMD128
+	const cv::v_float32x4 vX1 = cv::v_setall_f32(x1);
+	const cv::v_float32x4 vY1 = cv::v_setall_f32(y1);
+	const cv::v_float32x4 vX2 = cv::v_setall_f32(x2);
+	const cv::v_float32x4 vY2 = cv::v_setall_f32(y2);
+	const cv::v_float32x4 vArea = cv::v_setall_f32(area);
+	const cv::v_float32x4 vZero = cv::v_setall_f32(0.f);
+	float ious[4];
+
+	for (; k + 4 <= keptCount; k += 4)
+	{
+		cv::v_float32x4 vW = cv::v_max(vZero, cv::v_min(vX2, cv::v_load(&kept.mX2[k])) - cv::v_max(vX1, cv::v_load(&kept.mX1[k])));
+		cv::v_float32x4 vH = cv::v_max(vZero, cv::v_min(vY2, cv::v_load(&kept.mY2[k])) - cv::v_max(vY1, cv::v_load(&kept.mY1[k])));
+		cv::v_float32x4 vInter = vW * vH;
+		cv::v_float32x4 vUnion = vArea + cv::v_load(&kept.mAreas[k]) - vInter;
+		cv::v_store(ious, vInter / vUnion);
+
+		for (int l = 0; l < 4; l++)
+		{
+			if (isOverlapOver(ious[l], nmsThreshold, box, boxes[kept.mIndices[k + l]])) return true;
+		}
+	}
+#endif
+
+	for (; k < keptCount; k++)
+	{
+		float w = std::max(0.f, std::min(x2, kept.mX2[k]) - std::max(x1, kept.mX1[k]));
+		float h = std::max(0.f, std::min(y2, kept.mY2[k]) - std::max(y1, kept.mY1[k]));
+		float inter = w * h;
+		float uni = area + kept.mAreas[k] - inter;
+
+		if (isOverlapOver(inter / uni, nmsThreshold, box, boxes[kept.mIndices[k]])) return true;
+	}
+
+	return false;
+}
+
+//þ soft-NMS. ġ ڽ  ʰ  exp(-IoU^2/sigma) ´.
+//  detection Confidences ٽ ϵȴ.
+void YOLO_v3_DNN::doSoftNMSProcess(const mePostprocessParams& params, mePostprocessScratch* scratch, DetectionResult* detection)
+{
+	auto& detection_ = *detection;
+	auto& scoreIndices = scratch->mNMSScoreIndices;
+
+	scoreIndices.clear();
+	for (size_t i = 0; i < detection_.Confidences.size(); i++)
+	{
+		if (detection_.Confidences[i] > params.mConfThreshold)
+		{
+			scoreIndices.push_back(std::make_pair(detection_.Confidences[i], (int)i));
+		}
+	}
+
+	size_t candidateCount = scoreIndices.size();
+	for (size_t i = 0; i < candidateCount; i++)
+	{
+		// ĺ       ´
+		size_t best = i;
+		for (size_t j = i + 1; j < candidateCount; j++)
+		{
+			if (scoreIndices[j].first > scoreIndices[best].first) best = j;
+		}
+		std::swap(scoreIndices[i], scoreIndices[best]);
+
+		if (scoreIndices[i].first <= params.mConfThreshold)
+		{
+			break;
+		}
+
+		int idx = scoreIndices[i].second;
+		detection_.Confidences[idx] = scoreIndices[i].first;
+		detection_.Indices.push_back(idx);
+		if ((params.mNMSTopK > 0) && ((int)detection_.Indices.size() >= params.mNMSTopK))
+		{
+			break;
+		}
+
+		const cv::Rect& box = detection_.Boxes[idx];
+		for (size_t j = i + 1; j < candidateCount; j++)
+		{
+			int jdx = scoreIndices[j].second;
+			if ((params.mNMSMode == NMS_PerClass) && (detection_.ClassIds[jdx] != detection_.ClassIds[idx]))
+			{
+				continue;
+			}
+
+			float overlap = 1.f - (float)cv::jaccardDistance(box, detection_.Boxes[jdx]);
+			scoreIndices[j].first *= std::exp(-(overlap * overlap) / params.mSoftNMSSigma);
+		}
+	}
+}
+
+// cv::dnn::NMSBoxes ȣ. , ӵ 񱳿 ܵд.
+void YOLO_v3_DNN::doNMSProcess_OpenCV(DetectionResult* detection)
+{
+	auto& detection_ = *detection;
+
+	// Perform non maximum suppression to eliminate redundant overlapping boxes with
+	// lower confidences
+	detection_.Indices.clear();
+	cv::dnn::NMSBoxes(detection_.Boxes, detection_.Confidences, mConfThreshold, mNMSThreshold, detection_.Indices);
+
+}
+
+//ο  Rect ̾ƿ´
+int YOLO_v3_DNN::GetObjectRects(InBoxChecker* inBoxChecker)
+{
+	return GetObjectRects(mDetection, inBoxChecker);
+}
+
+//ġ   ܺο   Rect ιڽüĿ Ѵ
+int YOLO_v3_DNN::GetObjectRects(const DetectionResult& detection, InBoxChecker* inBoxChecker)
+{
+	InBoxChecker& inBoxChecker_ = *inBoxChecker;
+
+	int classId;
+	std::string label;
+	for (size_t i = 0; i < detection.Indices.size(); ++i)
+	{
+		classId = detection.ClassIds[detection.Indices[i]];
+		CV_Assert(classId < (int)mClasses.size());
+		label = mClasses[classId];
+
+		inBoxChecker_.AddBox(detection.Boxes[detection.Indices[i]], InBoxChecker::YOLOv3, label);
+	}
+
+	return (int)detection.Indices.size();
+}
+
+//ο  Rect ̿ؼ ڽ ׸.
+void YOLO_v3_DNN::DrawBoxes(cv::Mat* currFrame,const bool& isDrawFrameTime) 
+{
+	for (size_t i = 0; i < mDetection.Indices.size(); ++i)
+	{
+		int idx = mDetection.Indices[i];
+		cv::Rect box = mDetection.Boxes[idx];
+		drawPred(mDetection.ClassIds[idx], mDetection.Confidences[idx], box, currFrame);
+	}
+
+	if (isDrawFrameTime)
+	{
+		drawFrameTime(currFrame);
+	}
+}
+
+//   Ÿ 
+void YOLO_v3_DNN::drawFrameTime(cv::Mat* currFrame)
+{
+	std::vector<double> layersTimes;
+	double freq = cv::getTickFrequency() / 1000;
+	double t = mNeuralNet.getPerfProfile(layersTimes) / freq;
+	std::string label = cv::format("Inference time for a frame : %.2f ms", t);
+	cv::putText(*currFrame, label, cv::Point(0, 15), cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(0, 0, 255));
+}
+
+bool YOLO_v3_DNN::SetConfidenceThreshold(const float& confidenceThreshold)
+{
+	if ((0.0f <= confidenceThreshold) && (confidenceThreshold <= 1.0f))
+	{
+		mConfThreshold = confidenceThreshold;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+bool YOLO_v3_DNN::SetNMSThreshold(const float& NMSThreshold)
+{
+	if ((0.0f <= NMSThreshold) && (NMSThreshold <= 1.0f))
+	{
+		mNMSThreshold = NMSThreshold;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+bool YOLO_v3_DNN::SetBatchSize(const int& batchSize)
+{
+	if (batchSize >= 1)
+	{
+		mBatchSize = batchSize;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+//Ÿ 忡 ̿ Ÿϳ ġ ȼ . 迡 ģ ü  ŸϿ   ´
+bool YOLO_v3_DNN::SetTileOverlap(const int& tileOverlap)
+{
+	if ((0 <= tileOverlap) && (tileOverlap < std::min(mInpWidth, mInpHeight)))
+	{
+		mTileOverlap = tileOverlap;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+//forward  带 eOutputHeads ÷  .  ü ũⰡ   ʿ 带 
+//  ٲ ص °  Ƿ .
+// ̸ Ʈũ  ϹǷ, 񵿱  ߷ 尡  ٷȴٰ ⼭ ٷ Ѵ
+bool YOLO_v3_DNN::SetOutputHeads(const int& outputHeads)
+{
+	if (((outputHeads & Head_All) != 0) && ((outputHeads & ~Head_All) == 0))
+	{
+		waitAsyncIdle();
+
+		mOutputHeads = outputHeads;
+		mOutputNames.clear();
+		if (mNeuralNet.empty() == false)
+		{
+			mGetOutputsNames(mNeuralNet);
+		}
+		ClearOutputCache();
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+// 忡 θ  . 1̸   θ 
+bool YOLO_v3_DNN::SetTrackingInterval(const int& trackingInterval)
+{
+	if (trackingInterval >= 1)
+	{
+		mTrackingInterval = trackingInterval;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+//  Ӱ   (0~255) ̺ ũ ݰ  θ 
+bool YOLO_v3_DNN::SetSceneChangeThreshold(const float& sceneChangeThreshold)
+{
+	if ((0.0f <= sceneChangeThreshold) && (sceneChangeThreshold <= 255.0f))
+	{
+		mSceneChangeThreshold = sceneChangeThreshold;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+// ũ  Ÿ    Ÿ 
+int YOLO_v3_DNN::GetTileCount(const cv::Size& frameSize)
+{
+	return (int)makeTileRects(frameSize).size();
+}
+
+//Ʈũ Է ũ⸦ ٲ۴. ũ Ʈũ 32  Ѵ.
+//ص ° Է ũ⸶ ٸǷ , ũ ĳô  ũ Ʈ  Ѵ.
+bool YOLO_v3_DNN::SetInputSize(const int& inpWidth, const int& inpHeight)
+{
+	if ((inpWidth < 32) || (inpHeight < 32) || (inpWidth % 32 != 0) || (inpHeight % 32 != 0))
+	{
+		return false;
+	}
+
+	if ((inpWidth == mInpWidth) && (inpHeight == mInpHeight))
+	{
+		return true;
+	}
+
+	mInpWidth = inpWidth;
+	mInpHeight = inpHeight;
+	mTileOverlap = std::min(mTileOverlap, std::min(mInpWidth, mInpHeight) / 2);
+
+	mOuts.clear();
+	ClearOutputCache();
+	if (mDiskCache != nullptr)
+	{
+		mDiskCache->SetInputSize(mInpWidth, mInpHeight);
+	}
+
+	return true;
+}
+
+cv::Size YOLO_v3_DNN::GetInputSize()
+{
+	return cv::Size(mInpWidth, mInpHeight);
+}
+
+//ܺο ص °  Ȧ óѴ. Ŀ  迡 Ѵ.
+void YOLO_v3_DNN::DecodeOutputs(const std::vector<cv::Mat>& outs, const cv::Size& frameSize, DetectionResult* detection, const bool& isMinMaxLocKernel)
+{
+	if (isMinMaxLocKernel)
+	{
+		doConfidenceProcess_MinMaxLoc(outs, frameSize, detection);
+	}
+	else
+	{
+		doConfidenceProcess(outs, frameSize, detection);
+	}
+}
+
+// Ų Ʈũ ° ؼ ´
+std::vector<cv::Mat> YOLO_v3_DNN::GetRawOutputs()
+{
+	std::vector<cv::Mat> rawOuts(mOuts.size());
+	for (size_t i = 0; i < mOuts.size(); ++i)
+	{
+		rawOuts[i] = mOuts[i].clone();
+	}
+	return rawOuts;
+}
+
+//PassThrough  ó ܺ ӿ . ó  迡 Ѵ.
+void YOLO_v3_DNN::PreprocessFrame(const cv::Mat& currFrame, cv::Mat* blob)
+{
+	doPreprocessFrame(currFrame, blob);
+}
+
+//ó ,  ۰ ٸ ּҷ   Ƚ. Է ũⰡ ״θ ù  ķδ  ʾƾ Ѵ.
+// ּҸ ϹǷ cv::resize ȿ   ӽ   Ҵ  ʴ´
+int YOLO_v3_DNN::GetPreprocessReallocCount()
+{
+	return mPreprocessReallocCount;
+}
+
+bool YOLO_v3_DNN::SetNMSMode(const eNMSMode& nmsMode)
+{
+	mNMSMode = nmsMode;
+	return true;
+}
+
+//NMS   ڽ ִ . 0̸  
+bool YOLO_v3_DNN::SetNMSTopK(const int& topK)
+{
+	if (topK >= 0)
+	{
+		mNMSTopK = topK;
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+bool YOLO_v3_DNN::SetSoftNMS(const bool& isSoftNMS, const float& sigma)
+{
+	if (sigma > 0.0f)
+	{
+		mbSoftNMS = isSoftNMS;
+		mSoftNMSSigma = sigma;
+		return true;
+	}
 	else
 	{
 		return false;
 	}
+}
+
+//ܺ  NMS . NMS  迡 Ѵ.
+void YOLO_v3_DNN::RunNMS(DetectionResult* detection, const bool& isOpenCVNMS)
+{
+	if (isOpenCVNMS)
+	{
+		doNMSProcess_OpenCV(detection);
+	}
+	else
+	{
+		doNMSProcess(detection);
+	}
+}
+
+YOLO_v3_DNN::meAsyncState::~meAsyncState()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mbStopRequested = true;
+	}
+	mCondition.notify_all();
+
+	if (mThread.joinable())
+	{
+		mThread.join();
+	}
+}
+
+//߷  带 . ĸ  SubmitFrame  ְ TryGetResult  .
+// ۰ ΰ  N forward ϶  N+1  ̸    ִ.
+//񵿱 尡  ִ ȿ  Ʈũ  PassThrough 迭 Լ θ ȵȴ.
+//Ȧ,  , Է ũ  ٲ㵵 ǰ,  ڿ SubmitFrame Ӻ ȴ.
+//   Ʈũ ü ־  forward  ٷȴٰ ȴ.
+bool YOLO_v3_DNN::StartAsyncInference()
+{
+	if (mNeuralNet.empty())
+	{
+		std::cerr << "Can't load the dnn net internally!" << std::endl;
+		std::cerr << "make a proper net before starting async inference" << std::endl;
+		return false;
+	}
+
+	if (mAsync != nullptr)
+	{
+		return true;
+	}
+
+	//SubmitFrame ص  ̸ 縸 ϹǷ 带   äд
+	mGetOutputsNames(mNeuralNet);
+
+	mAsync = std::make_shared<meAsyncState>();
+	mAsync->mThread = std::thread(&YOLO_v3_DNN::asyncInferenceLoop, this, mAsync.get());
+
+	return true;
+}
+
+//񵿱    ۰  ,  ߷ 尡 Ʈũ   ٸ.
+//SubmitFrame Ʈũ ٲٴ Լ  忡 θǷ ٸ ڿ    ʴ´
+void YOLO_v3_DNN::waitAsyncIdle()
+{
+	if (mAsync == nullptr)
+	{
+		return;
+	}
+
+	meAsyncState& async_ = *mAsync;
+	std::unique_lock<std::mutex> lock(async_.mMutex);
+	async_.mIdleCondition.wait(lock, [&async_]()
+	{
+		return async_.mSlots[0].mState == SLOT_Free && async_.mSlots[1].mState == SLOT_Free;
+	});
+}
+
+// ִ forward  ٸ  带 ݴ´.    
+void YOLO_v3_DNN::StopAsyncInference()
+{
+	mAsync.reset();
+}
+
+// ִ  ۿ ְ  ȣ ش. ϸ -1
+// ۰     forward       ڸ 
+int YOLO_v3_DNN::SubmitFrame(const cv::Mat& currFrame)
+{
+	if (mAsync == nullptr)
+	{
+		std::cerr << "async inference is not started!" << std::endl;
+		std::cerr << "call StartAsyncInference before use this function" << std::endl;
+		return -1;
+	}
+
+	meAsyncState& async_ = *mAsync;
+	auto submitTime = std::chrono::high_resolution_clock::now();
+
+	int slotIndex = -1;
+	{
+		std::lock_guard<std::mutex> lock(async_.mMutex);
+
+		for (int i = 0; i < 2; i++)
+		{
+			if (async_.mSlots[i].mState == SLOT_Free)
+			{
+				slotIndex = i;
+				break;
+			}
+		}
+
+		if (slotIndex == -1)
+		{
+			for (int i = 0; i < 2; i++)
+			{
+				if (async_.mSlots[i].mState == SLOT_Pending)
+				{
+					slotIndex = i;
+					async_.mDroppedFrameCount++;
+					break;
+				}
+			}
+		}
+
+		if (slotIndex == -1)
+		{
+			return -1;
+		}
+
+		async_.mSlots[slotIndex].mState = SLOT_Filling;
+	}
+
+	// °  ۿ Ѵ.   ߷  ٸ ۷ forward 
+	// ̸ Ȧ嵵 ⼭  д. ߷     Ƿ ĸ ʿ  ٲ㵵 ȴ.
+	// ̸ Ʈũ ٲٴ Լ ߷ 尡  ̸ صιǷ, ⼭ Ʈũ ǵ帮 ʴ´
+	meAsyncSlot& slot = async_.mSlots[slotIndex];
+	doPreprocessFrame(currFrame, &slot.mBlob);
+	slot.mFrameSize = currFrame.size();
+	slot.mSubmitTime = submitTime;
+	slot.mOutputNames = mOutputNames;
+	slot.mParams = makePostprocessParams();
+
+	int frameId;
+	{
+		std::lock_guard<std::mutex> lock(async_.mMutex);
+		frameId = async_.mNextFrameId++;
+		slot.mFrameId = frameId;
+		slot.mState = SLOT_Pending;
+	}
+	async_.mCondition.notify_one();
+
+	return frameId;
+}
+
+//     ͺ ϳ .  ٸ ʰ false
+bool YOLO_v3_DNN::TryGetResult(AsyncResult* result)
+{
+	if (mAsync == nullptr)
+	{
+		return false;
+	}
+
+	meAsyncState& async_ = *mAsync;
+	std::lock_guard<std::mutex> lock(async_.mMutex);
+
+	if (async_.mResults.empty())
+	{
+		return false;
+	}
+
+	*result = std::move(async_.mResults.front());
+	async_.mResults.pop_front();
+
+	return true;
+}
+
+//forward ϱ   ӿ з   
+int YOLO_v3_DNN::GetDroppedFrameCount()
+{
+	if (mAsync == nullptr)
+	{
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(mAsync->mMutex);
+	return mAsync->mDroppedFrameCount;
+}
+
+void YOLO_v3_DNN::asyncInferenceLoop(meAsyncState* asyncState)
+{
+	meAsyncState& async_ = *asyncState;
+	std::vector<cv::Mat> outs;
+	//ĺ, NMS ۴ ĸ  mScratch  д
+	mePostprocessScratch scratch;
+
+	while (true)
+	{
+		int slotIndex = -1;
+		{
+			std::unique_lock<std::mutex> lock(async_.mMutex);
+			async_.mCondition.wait(lock, [&async_]()
+			{
+				return async_.mbStopRequested || async_.mSlots[0].mState == SLOT_Pending || async_.mSlots[1].mState == SLOT_Pending;
+			});
+
+			if (async_.mbStopRequested)
+			{
+				break;
+			}
+
+			//  ̸   Ӻ
+			for (int i = 0; i < 2; i++)
+			{
+				if (async_.mSlots[i].mState == SLOT_Pending && (slotIndex == -1 || async_.mSlots[i].mFrameId < async_.mSlots[slotIndex].mFrameId))
+				{
+					slotIndex = i;
+				}
+			}
+			async_.mSlots[slotIndex].mState = SLOT_Running;
+		}
+
+		meAsyncSlot& slot = async_.mSlots[slotIndex];
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		AsyncResult result;
+		result.FrameId = slot.mFrameId;
+
+		mNeuralNet.setInput(slot.mBlob);
+		mNeuralNet.forward(outs, slot.mOutputNames);
+		doConfidenceProcess(outs, slot.mFrameSize, slot.mParams, &scratch, &result.Detection);
+		doNMSProcess(slot.mParams, &scratch, &result.Detection);
+
+		auto endTime = std::chrono::high_resolution_clock::now();
+		result.QueueLatency = std::chrono::duration<double, std::milli>(startTime - slot.mSubmitTime).count();
+		result.InferenceTime = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+		result.TotalLatency = std::chrono::duration<double, std::milli>(endTime - slot.mSubmitTime).count();
+
+		{
+			std::lock_guard<std::mutex> lock(async_.mMutex);
+			async_.mResults.push_back(std::move(result));
+			slot.mState = SLOT_Free;
+		}
+		async_.mIdleCondition.notify_all();
+	}
+}
+
+
+YOLO_v3_DNN::meSwapState::~meSwapState()
+{
+	if (mThread.joinable())
+	{
+		mThread.join();
+	}
+}
+
+// cfg, weights, names ׶ 忡 а ־ صд.  Ʈũ ״    ִ.
+//Է ũ,  , ũ ĳ    . ̹ д ̸ false
+bool YOLO_v3_DNN::StartModelSwap(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights)
+{
+	if (mSwap == nullptr)
+	{
+		mSwap = std::make_shared<meSwapState>();
+	}
+
+	auto& swap_ = *mSwap;
+	{
+		std::lock_guard<std::mutex> lock(swap_.mMutex);
+		if (swap_.mbLoading)
+		{
+			return false;
+		}
+		swap_.mbLoading = true;
+		swap_.mReadyModel.reset();
+	}
+
+	//  ε  
+	if (swap_.mThread.joinable())
+	{
+		swap_.mThread.join();
+	}
+
+	//   νϽ ε  this ǵ帮 ʴ´
+	auto nextModel = std::make_shared<YOLO_v3_DNN>(mConfThreshold, mNMSThreshold, mInpWidth, mInpHeight);
+	nextModel->SetOutputHeads(mOutputHeads);
+	std::string cacheFolder = (mDiskCache != nullptr) ? mDiskCache->GetCacheFolder() : std::string();
+
+	meSwapState* swapState = mSwap.get();
+	swap_.mThread = std::thread([swapState, nextModel, classesFile, modelConfiguration, modelWeights, cacheFolder]()
+	{
+		bool isLoaded = false;
+		try
+		{
+			auto startTime = std::chrono::high_resolution_clock::now();
+			MappedFile cfgFile;
+			MappedFile weightsFile;
+			if (cfgFile.Open(modelConfiguration) && weightsFile.Open(modelWeights))
+			{
+				isLoaded = nextModel->MakeYOLONetFromMemory(classesFile, modelConfiguration, modelWeights,
+					cfgFile.GetData(), cfgFile.GetSize(), weightsFile.GetData(), weightsFile.GetSize());
+			}
+			else
+			{
+				// ȵǸ MakeYOLONetFromFileó η д´
+				isLoaded = nextModel->setLoadedNet(cv::dnn::readNetFromDarknet(modelConfiguration, modelWeights),
+					classesFile, modelConfiguration, modelWeights);
+			}
+			auto endTime = std::chrono::high_resolution_clock::now();
+			nextModel->mStartupProfile.ParseTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / 1000.0;
+
+			if (isLoaded)
+			{
+				nextModel->WarmUp();
+				// ؽø  ؾ ϹǷ ũ ĳõ ⼭ 
+				if (cacheFolder.empty() == false)
+				{
+					nextModel->EnableDiskCache(cacheFolder);
+				}
+			}
+		}
+		catch (const cv::Exception& e)
+		{
+			std::cerr << "Can't load the new dnn net : " << e.what() << std::endl;
+			isLoaded = false;
+		}
+
+		if (isLoaded == false)
+		{
+			std::cerr << "model swap failed, keep using the current model" << std::endl;
+			std::cerr << "cfg-file:     " << modelConfiguration << std::endl;
+			std::cerr << "weights-file: " << modelWeights << std::endl;
+		}
+
+		std::lock_guard<std::mutex> lock(swapState->mMutex);
+		swapState->mbLoading = false;
+		if (isLoaded)
+		{
+			swapState->mReadyModel = nextModel;
+		}
+	});
+
+	return true;
+}
+
+//д ̰ų,  а ü ٸ  ִ
+bool YOLO_v3_DNN::IsModelSwapPending()
+{
+	if (mSwap == nullptr)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(mSwap->mMutex);
+	return mSwap->mbLoading || (mSwap->mReadyModel != nullptr);
+}
+
+//غ     Ʈũ ٲ۴.  (PassThrough, SubmitFrame ȣ ) θ ȴ.
+// Լ θ     Ʈũ . 񵿱 尡   ̹ SubmitFrame 
+// Ʈũ   ٸ  ٲ۴. ߷  ״ ΰ,  SubmitFrame  Ʈũ 
+bool YOLO_v3_DNN::SwapModelIfReady()
+{
+	if (mSwap == nullptr)
+	{
+		return false;
+	}
+
+	std::shared_ptr<YOLO_v3_DNN> readyModel;
+	{
+		std::lock_guard<std::mutex> lock(mSwap->mMutex);
+		readyModel.swap(mSwap->mReadyModel);
+	}
+	if (readyModel == nullptr)
+	{
+		return false;
+	}
+
+	auto& readyModel_ = *readyModel;
+
+	//߷ 尡 Ʈũ   ٸ
+	waitAsyncIdle();
+
+	mNeuralNet = readyModel_.mNeuralNet;
+	mClasses = readyModel_.mClasses;
+	mModelConfiguration = readyModel_.mModelConfiguration;
+	mModelWeights = readyModel_.mModelWeights;
+	mOutputNames = readyModel_.mOutputNames;
+	mStartupProfile = readyModel_.mStartupProfile;
+	mbQuantized = false;
+
+	//ε ߿  尡 ٲ ̸ ٽ Ѵ
+	if (readyModel_.mOutputHeads != mOutputHeads)
+	{
+		mOutputNames.clear();
+		mGetOutputsNames(mNeuralNet);
+	}
+
+	//  °    ̻  ʴ´
+	ClearOutputCache();
+	ResetTracking();
+	mOuts.clear();
+	if (mDiskCache != nullptr)
+	{
+		mDiskCache = readyModel_.mDiskCache;
+		if (mDiskCache != nullptr)
+		{
+			mDiskCache->SetInputSize(mInpWidth, mInpHeight);
+		}
+	}
+
+	return true;
+}
+
+//forward ̾ ð . frameWindow ֱ forward .
+// PassThrough 迭 , ũ ĳÿ   forward Ƿ 
+bool YOLO_v3_DNN::StartLayerProfiling(const int& frameWindow)
+{
+	if (frameWindow < 1)
+	{
+		return false;
+	}
+
+	mbLayerProfiling = true;
+	mProfileWindow = frameWindow;
+	mProfileLayerNames.clear();
+	mProfileLayerTypes.clear();
+	mProfileSamples.clear();
+	mProfileTotals.clear();
+
+	return true;
+}
+
+//⸸ .   GetInferenceProfile    ִ
+void YOLO_v3_DNN::StopLayerProfiling()
+{
+	mbLayerProfiling = false;
+}
+
+//  forward ̾ ð getPerfProfile  Ѵ
+void YOLO_v3_DNN::recordLayerTimings()
+{
+	if (mbLayerProfiling == false)
+	{
+		return;
+	}
+
+	std::vector<double> layersTimes;
+	double freq = cv::getTickFrequency() / 1000;
+	double total = mNeuralNet.getPerfProfile(layersTimes) / freq;
+
+	//̾ ̸ ó̳ Ʈũ ٲ ̾  ޶ ٽ Ѵ
+	if (mProfileLayerNames.size() != layersTimes.size())
+	{
+		mProfileLayerNames = mNeuralNet.getLayerNames();
+		mProfileLayerTypes.resize(mProfileLayerNames.size());
+		for (size_t i = 0; i < mProfileLayerNames.size(); i++)
+		{
+			mProfileLayerTypes[i] = mNeuralNet.getLayer(mProfileLayerNames[i])->type;
+		}
+		mProfileSamples.clear();
+		mProfileTotals.clear();
+	}
+
+	for (size_t i = 0; i < layersTimes.size(); i++)
+	{
+		layersTimes[i] /= freq;
+	}
+
+	mProfileSamples.push_back(layersTimes);
+	mProfileTotals.push_back(total);
+	while ((int)mProfileSamples.size() > mProfileWindow)
+	{
+		mProfileSamples.pop_front();
+		mProfileTotals.pop_front();
+	}
+}
+
+// ؼ min, mean, p95(nearest-rank) Ѵ
+static void getTimeStats(std::vector<double>* values, double* minTime, double* meanTime, double* p95Time)
+{
+	auto& values_ = *values;
+
+	if (values_.empty())
+	{
+		*minTime = *meanTime = *p95Time = 0.0;
+		return;
+	}
+
+	std::sort(values_.begin(), values_.end());
+
+	double sum = 0.0;
+	for (size_t i = 0; i < values_.size(); i++)
+	{
+		sum += values_[i];
+	}
+
+	size_t p95Index = (size_t)std::ceil(0.95 * values_.size()) - 1;
+
+	*minTime = values_.front();
+	*meanTime = sum / values_.size();
+	*p95Time = values_[p95Index];
+}
+
+//Ƶ forward ̾ min/mean/p95 ð(ms).  带    ̾ 0̴
+YOLO_v3_DNN::InferenceProfile YOLO_v3_DNN::GetInferenceProfile()
+{
+	InferenceProfile profile;
+	profile.FrameCount = (int)mProfileSamples.size();
+
+	std::vector<double> values(mProfileTotals.begin(), mProfileTotals.end());
+	getTimeStats(&values, &profile.MinTotal, &profile.MeanTotal, &profile.P95Total);
+
+	profile.Layers.resize(mProfileLayerNames.size());
+	for (size_t i = 0; i < mProfileLayerNames.size(); i++)
+	{
+		auto& layer = profile.Layers[i];
+		layer.Name = mProfileLayerNames[i];
+		layer.Type = mProfileLayerTypes[i];
+
+		values.clear();
+		for (size_t f = 0; f < mProfileSamples.size(); f++)
+		{
+			values.push_back(mProfileSamples[f][i]);
+		}
+		getTimeStats(&values, &layer.MinTime, &layer.MeanTime, &layer.P95Time);
+	}
+
+	return profile;
+}
+
+//̾ 踦 CSV Ѵ.   forward ü ð
+bool YOLO_v3_DNN::SaveInferenceProfileCSV(const std::string& path)
+{
+	InferenceProfile profile = GetInferenceProfile();
+
+	std::ofstream writeT;
+	writeT.open(path);
+	if (writeT.is_open() == false)
+	{
+		return false;
+	}
+
+	writeT << "Layer,Type,Min(ms),Mean(ms),P95(ms)\n";
+	for (size_t i = 0; i < profile.Layers.size(); i++)
+	{
+		auto& layer = profile.Layers[i];
+		writeT << layer.Name << "," << layer.Type << "," << layer.MinTime << "," << layer.MeanTime << "," << layer.P95Time << "\n";
+	}
+	writeT << "total,forward," << profile.MinTotal << "," << profile.MeanTotal << "," << profile.P95Total << "\n";
+	writeT.close();
+
+	return true;
+}
+
+//̾ 踦 JSON Ѵ. ũ ̾ ̸ ǥ ð  ״ 
+bool YOLO_v3_DNN::SaveInferenceProfileJSON(const std::string& path)
+{
+	InferenceProfile profile = GetInferenceProfile();
+
+	std::ofstream writeT;
+	writeT.open(path);
+	if (writeT.is_open() == false)
+	{
+		return false;
+	}
+
+	writeT << "{\n";
+	writeT << "  \"frameCount\": " << profile.FrameCount << ",\n";
+	writeT << "  \"inputSize\": [" << mInpWidth << ", " << mInpHeight << "],\n";
+	writeT << "  \"total\": { \"min\": " << profile.MinTotal << ", \"mean\": " << profile.MeanTotal << ", \"p95\": " << profile.P95Total << " },\n";
+	writeT << "  \"layers\": [\n";
+	for (size_t i = 0; i < profile.Layers.size(); i++)
+	{
+		auto& layer = profile.Layers[i];
+		writeT << "    { \"name\": \"" << layer.Name << "\", \"type\": \"" << layer.Type << "\", \"min\": " << layer.MinTime
+			<< ", \"mean\": " << layer.MeanTime << ", \"p95\": " << layer.P95Time << " }" << ((i + 1 < profile.Layers.size()) ? "," : "") << "\n";
+	}
+	writeT << "  ]\n";
+	writeT << "}\n";
+	writeT.close();
+
+	return true;
 }
\ No newline at end of file
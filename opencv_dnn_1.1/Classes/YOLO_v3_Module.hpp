@@ -6,6 +6,7 @@
 #include <opencv2\core.hpp>
 #include <opencv2\highgui.hpp>
 #include <opencv2\imgproc\imgproc.hpp>
+#include <opencv2/core/hal/intrin.hpp>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -13,49 +14,288 @@
 #include <math.h>
 #include <algorithm> 
 #include <queue>
+#include <map>
+#include <memory>
+#include <float.h>
+#include <chrono>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <sstream>
 #include <iostream>
 #include <fstream>
 
 #include "InBoxChecker_Tool.hpp"
+#include "DNNOutputCache_Tool.hpp"
+#include "MappedFile_Tool.hpp"
 
 
 class YOLO_v3_DNN
 {
+public:
+	enum eNMSMode { NMS_ClassAgnostic = 0, NMS_PerClass = 1 };
+	// Output heads in network order. Stride 32 is the coarsest grid (large objects), stride 8 the finest (small objects)
+	enum eOutputHeads { Head_Stride32 = 1, Head_Stride16 = 2, Head_Stride8 = 4, Head_All = 7 };
+	struct DetectionResult
+	{
+		std::vector<int> ClassIds;
+		std::vector<float> Confidences;
+		std::vector<cv::Rect> Boxes;
+		std::vector<int> Indices;
+	};
+	struct StartupProfile
+	{
+		double ParseTime;       // ms, mapping the files + building the net from the buffers
+		double AllocateTime;    // ms, first forward on a dummy blob (layer setup, blob allocation)
+		double WarmUpTime;      // ms, second forward on a dummy blob (steady state)
+		double TotalTime;       // ms, sum of the above = time until the net is ready for the first frame
+	};
+	struct LayerProfile
+	{
+		std::string Name;
+		std::string Type;
+		double MinTime;         // ms
+		double MeanTime;        // ms
+		double P95Time;         // ms
+	};
+	struct InferenceProfile
+	{
+		int FrameCount;
+		double MinTotal;        // ms, whole forward
+		double MeanTotal;
+		double P95Total;
+		std::vector<LayerProfile> Layers; // Network order
+	};
+	struct AsyncResult
+	{
+		int FrameId;
+		DetectionResult Detection;
+		double QueueLatency;    // ms, SubmitFrame ~ forward start
+		double InferenceTime;   // ms, forward + post processing
+		double TotalLatency;    // ms, SubmitFrame ~ result ready
+	};
 private:
 	float mConfThreshold = 0.2; // Confidence threshold
 	float mNMSThreshold = 0.4;  // Non-maximum suppression threshold
 	int mInpWidth = 416;        // Width of network's input image
 	int mInpHeight = 416;       // Height of network's input image
+	int mBatchSize = 8;         // Number of frames per forward pass in batch mode
+	int mTileOverlap = 64;      // Overlap between neighbouring tiles in tiled mode (pixel)
+	int mOutputHeads = Head_All; // eOutputHeads flags of the heads to forward
+	bool mbQuantized = false;   // Network was quantized to INT8 from the float model
+	int mTrackingInterval = 5;  // Run YOLO every N frames in tracking mode
+	float mSceneChangeThreshold = 12.0f; // Mean gray difference from the last YOLO frame that forces a YOLO run
+
+	eNMSMode mNMSMode = NMS_ClassAgnostic;
+	int mNMSTopK = 0;           // Maximum kept boxes after NMS, 0 = no limit
+	bool mbSoftNMS = false;
+	float mSoftNMSSigma = 0.5f;
 
 	cv::dnn::Net mNeuralNet;
+	std::string mModelConfiguration;
+	std::string mModelWeights;
+	std::shared_ptr<DNNOutputCache> mDiskCache;
+	std::vector<std::string> mOutputNames;
+	StartupProfile mStartupProfile = {};
+
+	bool mbLayerProfiling = false;
+	int mProfileWindow = 100;   // Number of latest forwards kept for the layer statistics
+	std::vector<std::string> mProfileLayerNames;
+	std::vector<std::string> mProfileLayerTypes;
+	std::deque<std::vector<double>> mProfileSamples; // Per forward, per layer time (ms)
+	std::deque<double> mProfileTotals;
 
 	cv::Mat mBlob;
+	cv::Mat mResizedFrame;
+	int mPreprocessReallocCount = 0;
 	std::vector<cv::Mat> mOuts;
+	std::map<std::string, std::vector<cv::Mat>> mOutsCache;
 	cv::Mat mDetectedFrame;
 
-	std::vector<int> mClassIds;
-	std::vector<float> mConfidences;
-	std::vector<cv::Rect> mBoxes;
+	DetectionResult mDetection;
+	DetectionResult mTrackedDetection;
 	std::vector<std::string> mClasses;
-	std::vector<int> mIndices;
+
+	struct meCandidateBuffer
+	{
+		std::vector<int> mClassIds;
+		std::vector<float> mConfidences;
+		std::vector<int> mLefts;
+		std::vector<int> mTops;
+		std::vector<int> mWidths;
+		std::vector<int> mHeights;
+	};
+
+	struct meKeptBoxes
+	{
+		std::vector<float> mX1;
+		std::vector<float> mY1;
+		std::vector<float> mX2;
+		std::vector<float> mY2;
+		std::vector<float> mAreas;
+		std::vector<int> mIndices;
+	};
+	// Settings read by the post processing, copied so the async worker never reads the live members
+	struct mePostprocessParams
+	{
+		float mConfThreshold;
+		float mNMSThreshold;
+		eNMSMode mNMSMode;
+		int mNMSTopK;
+		bool mbSoftNMS;
+		float mSoftNMSSigma;
+	};
+	// Buffers reused by the post processing. The calling thread uses mScratch, the async worker owns its own
+	struct mePostprocessScratch
+	{
+		meCandidateBuffer mCandidates;
+		std::vector<std::pair<float, int>> mNMSScoreIndices;
+		std::vector<meKeptBoxes> mNMSKeptBoxes;
+	};
+	mePostprocessScratch mScratch;
+
+	cv::Mat mTrackGrayFull;
+	cv::Mat mTrackCurrGray;     // downsampled gray of the current frame
+	cv::Mat mTrackPrevGray;     // downsampled gray of the previous frame
+	cv::Mat mTrackKeyGray;      // downsampled gray of the last YOLO frame
+	cv::Mat mTrackDiff;
+	cv::Mat mTrackScores;
+	int mFramesSinceDetection = 0;
+	int mDetectedFrameCount = 0;
+	int mTrackedFrameCount = 0;
+	bool mbLastFrameDetected = false;
+
+	enum eAsyncSlotState { SLOT_Free = 0, SLOT_Filling = 1, SLOT_Pending = 2, SLOT_Running = 3 };
+	struct meAsyncSlot
+	{
+		cv::Mat mBlob;
+		cv::Size mFrameSize;
+		int mFrameId = -1;
+		eAsyncSlotState mState = SLOT_Free;
+		std::vector<std::string> mOutputNames; // Snapshot taken at SubmitFrame
+		mePostprocessParams mParams;           // Snapshot taken at SubmitFrame
+		std::chrono::high_resolution_clock::time_point mSubmitTime;
+	};
+	struct meAsyncState
+	{
+		std::thread mThread;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		std::condition_variable mIdleCondition; // Signalled whenever the worker frees a slot
+		bool mbStopRequested = false;
+		meAsyncSlot mSlots[2];
+		std::deque<AsyncResult> mResults;
+		int mNextFrameId = 0;
+		int mDroppedFrameCount = 0;
+		~meAsyncState();
+	};
+	struct meSwapState
+	{
+		std::thread mThread;
+		std::mutex mMutex;
+		bool mbLoading = false;
+		std::shared_ptr<YOLO_v3_DNN> mReadyModel; // Loaded and warmed up, waiting for SwapModelIfReady
+		~meSwapState();
+	};
+	// Created in StartModelSwap, held by pointer since thread/mutex are not copyable
+	std::shared_ptr<meSwapState> mSwap;
+
+	// Created in StartAsyncInference, held by pointer since thread/mutex are not copyable
+	std::shared_ptr<meAsyncState> mAsync;
 
 
 	void drawPred(const int& classId, const float& conf, const cv::Rect& box, cv::Mat* currFrame);
 	std::vector<std::string> mGetOutputsNames(const cv::dnn::Net& net);
+	void reopenDiskCache();
+	void waitAsyncIdle();
+	bool setLoadedNet(const cv::dnn::Net& net, const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights);
 
+	void doPreprocessFrame(const cv::Mat& frame, cv::Mat* blob);
 	void doPostprocessFrame(cv::Mat* currFrame);
-	void doConfidenceProcess(cv::Mat* currFrame);
-	void doNMSProcess();
+	mePostprocessParams makePostprocessParams();
+	void doConfidenceProcess(const std::vector<cv::Mat>& outs, const cv::Size& frameSize, DetectionResult* detection);
+	void doConfidenceProcess(const std::vector<cv::Mat>& outs, const cv::Size& frameSize, const mePostprocessParams& params,
+		mePostprocessScratch* scratch, DetectionResult* detection);
+	void doConfidenceProcess_MinMaxLoc(const std::vector<cv::Mat>& outs, const cv::Size& frameSize, DetectionResult* detection);
+	int decodeOutputRows(const cv::Mat& out, const cv::Size& frameSize, const float& confThreshold, meCandidateBuffer* candidates, const int& startCount);
+	void doNMSProcess(DetectionResult* detection);
+	void doNMSProcess(const mePostprocessParams& params, mePostprocessScratch* scratch, DetectionResult* detection);
+	void doNMSProcess_OpenCV(DetectionResult* detection);
+	void doSoftNMSProcess(const mePostprocessParams& params, mePostprocessScratch* scratch, DetectionResult* detection);
+	bool isSuppressedByKept(const meKeptBoxes& kept, const cv::Rect& box, const std::vector<cv::Rect>& boxes, const float& nmsThreshold);
+	void asyncInferenceLoop(meAsyncState* asyncState);
+	std::vector<cv::Rect> makeTileRects(const cv::Size& frameSize);
+	bool isSceneChanged(const cv::Mat& currGray);
+	void doTrackBoxes(const cv::Mat& prevGray, const cv::Mat& currGray, DetectionResult* detection);
+	void doTileMergeProcess(const std::vector<cv::Rect>& tileRects, const std::vector<DetectionResult>& tileDetections, DetectionResult* detection);
 	void drawFrameTime(cv::Mat* currFrame);
+	void recordLayerTimings();
 public:
+	// Not copyable: the async and swap threads are bound to this instance
+	YOLO_v3_DNN(const YOLO_v3_DNN&) = delete;
+	YOLO_v3_DNN& operator=(const YOLO_v3_DNN&) = delete;
 	YOLO_v3_DNN(const float& confThreshold = 0.2, const float& nmsThreshold = 0.4, const int& inpWidth = 416, const int& inpHeight = 416);
-	void MakeYOLONetFromFile(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights);
+	void MakeYOLONetFromFile(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights, const bool& isWarmUp = false);
+	bool MakeQuantizedYOLONetFromFile(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights,
+		const std::vector<cv::Mat>& calibrationFrames);
+	bool MakeYOLONetFromMemory(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights,
+		const char* cfgBuffer, const size_t& cfgSize, const char* weightsBuffer, const size_t& weightsSize);
+	bool IsQuantized();
+	bool WarmUp();
+	StartupProfile GetStartupProfile();
+	bool GetMemoryConsumption(size_t* weightsBytes, size_t* blobsBytes);
 	void PassThroughWithPostProcessing(const cv::Mat& currFrame, cv::Mat* detectedFrame);
 	bool PassThrough(cv::Mat* currFrame);
+	bool PassThrough(const cv::Mat& currFrame, DetectionResult* detection);
+	bool PassThrough(cv::Mat* currFrame, const std::string& cacheKey);
+	void ClearOutputCache();
+	bool EnableDiskCache(const std::string& cacheFolder);
+	void DisableDiskCache();
+	bool PassThroughBatch(const std::vector<cv::Mat>& frames, std::vector<DetectionResult>* detections);
+	bool PassThroughTiled(cv::Mat* currFrame);
+	bool PassThroughTracked(cv::Mat* currFrame);
+	void ResetTracking();
+	bool IsLastFrameDetected();
+	float GetYOLODutyCycle();
 	int GetObjectRects(InBoxChecker* inBoxChecker);
+	int GetObjectRects(const DetectionResult& detection, InBoxChecker* inBoxChecker);
 	void DrawBoxes(cv::Mat* currFrame, const bool& isDrawFrameTime = true);
 
 	bool SetConfidenceThreshold(const float& confidenceThreshold);
 	bool SetNMSThreshold(const float& NMSThreshold);
+	bool SetBatchSize(const int& batchSize);
+	bool SetInputSize(const int& inpWidth, const int& inpHeight);
+	cv::Size GetInputSize();
+	bool SetTileOverlap(const int& tileOverlap);
+	bool SetOutputHeads(const int& outputHeads);
+	bool SetTrackingInterval(const int& trackingInterval);
+	bool SetSceneChangeThreshold(const float& sceneChangeThreshold);
+	int GetTileCount(const cv::Size& frameSize);
+
+	void DecodeOutputs(const std::vector<cv::Mat>& outs, const cv::Size& frameSize, DetectionResult* detection, const bool& isMinMaxLocKernel = false);
+	std::vector<cv::Mat> GetRawOutputs();
+	void PreprocessFrame(const cv::Mat& currFrame, cv::Mat* blob);
+	int GetPreprocessReallocCount();
+
+	bool SetNMSMode(const eNMSMode& nmsMode);
+	bool SetNMSTopK(const int& topK);
+	bool SetSoftNMS(const bool& isSoftNMS, const float& sigma = 0.5f);
+	void RunNMS(DetectionResult* detection, const bool& isOpenCVNMS = false);
+
+	bool StartAsyncInference();
+	void StopAsyncInference();
+	int SubmitFrame(const cv::Mat& currFrame);
+	bool TryGetResult(AsyncResult* result);
+	int GetDroppedFrameCount();
+
+	bool StartModelSwap(const std::string& classesFile, const std::string& modelConfiguration, const std::string& modelWeights);
+	bool IsModelSwapPending();
+	bool SwapModelIfReady();
+
+	bool StartLayerProfiling(const int& frameWindow = 100);
+	void StopLayerProfiling();
+	InferenceProfile GetInferenceProfile();
+	bool SaveInferenceProfileCSV(const std::string& path);
+	bool SaveInferenceProfileJSON(const std::string& path);
 };
\ No newline at end of file
@@ -22,6 +22,8 @@
 #include "Classes/PylonCameraModule.hpp"
 
 #include "Classes/InBoxChecker_Tool.hpp"
+#include "Classes/FrameChangeGate_Tool.hpp"
+#include "Classes/LatencyGovernor_Tool.hpp"
 
 #include "Classes/GrayScale_Module.hpp"
 #include "Classes/ColorDetection_Module.hpp"
@@ -50,6 +52,9 @@ float nmsThreshold = 0.5;  // Non-maximum suppression threshold
 int inpWidth = 608;        // Width of network's input image
 int inpHeight = 608;
 
+//  ģ ǥ ó ð.  Źʰ  Է° ÷ ؼ ڸ 
+static const double TARGET_FRAME_TIME = 200.0; // ms
+
 //--------------------------------------------------------------
 int pos_hue = 20;
 int mid_hue = 10;
@@ -65,8 +70,11 @@ cv::Mat HLS_frame;
 //̸  BoxChecker 
 InBoxChecker InBoxChecker_Tool = InBoxChecker();
 
+//ִ  ǳʶٴ  ȭ Ʈ 
+FrameChangeGate FrameChangeGate_Tool = FrameChangeGate(cv::Size(32, 24), 3.0f);
+
 //dnn network settings for object detection
-YOLO_v3_DNN YOLO_v3_Module = YOLO_v3_DNN(confThreshold, nmsThreshold, inpWidth, inpHeight);
+YOLO_v3_DNN YOLO_v3_Module(confThreshold, nmsThreshold, inpWidth, inpHeight);
 
 //̸  ColorDetection  
 ColorDetection ColorDetection_Module = ColorDetection(ColorDetection::F9x9, ColorDetection::S11x11);
@@ -74,6 +82,9 @@ ColorDetection ColorDetection_Module = ColorDetection(ColorDetection::F9x9, Colo
 //̸  GrayScale  
 GrayScaleCalculator GrayScale_Module = GrayScaleCalculator(GrayScaleCalculator::RGB_Luminance);
 
+//ó ð  ǰ ܰ踦 ٲٴ Ź . 2ܰ谡  608, F9x9, S11x11 ̴
+LatencyGovernor LatencyGovernor_Tool = LatencyGovernor(TARGET_FRAME_TIME, 2);
+
 //ķ ī޶ Ʈ
 //OCam OCam_Camera = OCam(OCam::W640_H480, OCam::FPS60);
 //׽Ʈ ķ Ʈ
@@ -83,15 +94,19 @@ PylonCamera PylonCam_Module;
 
 //--------------------------------׿ Լ, Ŭ ̺Ʈ --------------------------------
 
-cv::Mat test_HSV;
 cv::Mat test_gray;
 
+//÷ ؼǿ HSV    Ƿ(, , Ÿ 带 ) Ŭ ȼ ϳ HSV ٲ㼭 
 void CallBackFunc(int event, int x, int y, int flags, void* userdata)
 {
-	if (event == cv::EVENT_LBUTTONDOWN)
+	if ((event == cv::EVENT_LBUTTONDOWN) && (0 <= x) && (x < frame.cols) && (0 <= y) && (y < frame.rows))
 	{
+		cv::Mat clickedHSV;
+		cv::cvtColor(frame(cv::Rect(x, y, 1, 1)), clickedHSV, cv::COLOR_BGR2HSV);
+		cv::Vec3b clickedValue = clickedHSV.at<cv::Vec3b>(0, 0);
+
 		cout << "pos : [" << x << "," << y << "]" << endl;
-		cout << "original HSL Value : " << (int)(test_HSV.at<cv::Vec3b>(cv::Point(x, y))[0]) << "/" << (int)(test_HSV.at<cv::Vec3b>(cv::Point(x, y))[1]) << "/" << (int)(test_HSV.at<cv::Vec3b>(cv::Point(x, y))[2]) << endl;
+		cout << "original HSL Value : " << (int)clickedValue[0] << "/" << (int)clickedValue[1] << "/" << (int)clickedValue[2] << endl;
 	}
 }
 
@@ -125,12 +140,32 @@ int main()
 	string classesFile = folderName + "/" + "object.names";
 	string modelConfiguration = folderName + "/" + "yolov3-obj-custom.cfg";
 	string modelWeights = folderName + "/" + "yolov3-obj-custom_1000.weights";
-	YOLO_v3_Module.MakeYOLONetFromFile(classesFile, modelConfiguration, modelWeights);
+	// ߿ 'm' Ű ٲ   üũƮ
+	string nextModelWeights = folderName + "/" + "yolov3-obj-custom_last.weights";
+	YOLO_v3_Module.MakeYOLONetFromFile(classesFile, modelConfiguration, modelWeights, true);
+	YOLO_v3_DNN::StartupProfile startupProfile = YOLO_v3_Module.GetStartupProfile();
+	cout << "YOLO startup : parse " << startupProfile.ParseTime << "ms / allocate " << startupProfile.AllocateTime
+		<< "ms / warm-up " << startupProfile.WarmUpTime << "ms / total " << startupProfile.TotalTime << "ms" << endl;
+	// ̹ ݺؼ  ° ũ ĳ 
+	//YOLO_v3_Module.EnableDiskCache("./dnnOutputCache");
+	//ĸĿ forward ļ  񵿱  .  SubmitFrame(frame) ְ TryGetResult  ´
+	//YOLO_v3_Module.StartAsyncInference();
 
 
 	//÷ ؼ  
 	ColorDetection_Module.AddColorDetectionRange(pos_hue, mid_hue, neg_hue,"Rust", 130);
 	ColorDetection_Module.MakeColorDetection("autoColorParameter_2_B2_M1", 10);
+	// /÷  â  jpg Ѵ. Ҷ 
+	ColorDetection_Module.SetDebugDisplay(true);
+	//ū ׸忡 Ͽ ε 󺧸 . ÷ʰ ڽ  ٸ  ־ ⺻ ÷̴
+	//ColorDetection_Module.SetLabelingEngine(ColorDetection::Labeling_UnionFind);
+	//ػ ī޶󿡼 ÷ ؼ    忡 (0̸ ھ ). HSV   nullptr ѱ涧 ȴ
+	//ColorDetection_Module.SetBandThreadCount(0);
+	//ū ӿ L2 ũ Ÿϸ ȯ ޵ ̾ Ѵ.  HSV   nullptr ѱ涧 ȴ
+	//ColorDetection_Module.SetTiledExecution(true, 256 * 1024);
+
+	//Ź  ܰ踦 鿡 
+	LatencyGovernor_Tool.ApplyLevel(&YOLO_v3_Module, &ColorDetection_Module);
 
 
 	//  
@@ -152,56 +187,98 @@ int main()
 		if (PylonCam_Module.GrabCameraFrame(&frame))
 		{
 			cv::imshow("pylon original frame", frame);
-			if (cv::waitKey(1) == 27)
+			int key = cv::waitKey(1);
+			if (key == 27)
 			{
 				break;
 			}
+			//  ׶忡 а ־Ѵ. ׵   𵨷  
+			if (key == 'm')
+			{
+				YOLO_v3_Module.StartModelSwap(classesFile, modelConfiguration, nextModelWeights);
+			}
 		}
 		else
 		{
 			break;
 		}
 
-		//-----  κ
+		//غ     ̿ ٲ۴.    Ʈ 
+		if (YOLO_v3_Module.SwapModelIfReady())
+		{
+			FrameChangeGate_Tool.Reset();
+		}
+
+		//----- ȭ Ʈ.  ó Ӱ     ǳʶٰ   
+		int detected_pixels = 0;
+		float res = 0.0f;
+		if (FrameChangeGate_Tool.IsChanged(frame))
+		{
+			//-----  κ
+
+			//ο   мϰ ڽ   , ̹ ó 
+			LatencyGovernor_Tool.BeginStage(LatencyGovernor::Stage_YOLO);
+			YOLO_v3_Module.PassThrough(&frame);
+			YOLO_v3_Module.GetObjectRects(&InBoxChecker_Tool);
+			LatencyGovernor_Tool.EndStage(LatencyGovernor::Stage_YOLO);
+			YOLO_v3_Module.DrawBoxes(&detectedFrame, true);
+
+			cv::imshow("YOLO Result", detectedFrame);
+			cv::imwrite("./imwrite_imgs/YOLO_Result.jpg", detectedFrame);
+			if (cv::waitKey(0) == 27);
 
-		//ο   мϰ ڽ   , ̹ ó 
-		YOLO_v3_Module.PassThrough(&frame);
-		YOLO_v3_Module.GetObjectRects(&InBoxChecker_Tool);
-		YOLO_v3_Module.DrawBoxes(&detectedFrame, true);
+			//  
+			cv::imshow("YOLO v3 result", detectedFrame);
 
-		cv::imshow("YOLO Result", detectedFrame);
-		cv::imwrite("./imwrite_imgs/YOLO_Result.jpg", detectedFrame);
-		if (cv::waitKey(0) == 27);
+			//-----÷ ؼ  κ
 
-		//  
-		cv::imshow("YOLO v3 result", detectedFrame);
+			//÷ ؼ ⿡ 
+			LatencyGovernor_Tool.BeginStage(LatencyGovernor::Stage_ColorDetection);
+			detected_pixels = ColorDetection_Module.PushThroughImage(frame, nullptr, &InBoxChecker_Tool);
+			//ϵ  ÷(,  ) ѹ  Ʒ  . Ŭ ڽ ȼ  colorResults 
+			//std::vector<ColorDetection::ColorDetectionResult> colorResults;
+			//detected_pixels = ColorDetection_Module.PushThroughImageAllRanges(frame, nullptr, &InBoxChecker_Tool, &colorResults);
+			LatencyGovernor_Tool.EndStage(LatencyGovernor::Stage_ColorDetection);
+			float Detected_pixel_ratio = ((float)detected_pixels) / (frame.cols * frame.rows);
+			cout << "detected Color Area Ratio : " << Detected_pixel_ratio << " / Pixels : " << detected_pixels << endl;
 
-		//-----÷ ؼ  κ
 
-		//÷ ؼ ⿡ 
-		int detected_pixels = ColorDetection_Module.PushThroughImage(frame, &test_HSV, &InBoxChecker_Tool);
-		float Detected_pixel_ratio = ((float)detected_pixels) / (frame.cols * frame.rows);
-		cout << "detected Color Area Ratio : " << Detected_pixel_ratio << " / Pixels : " << detected_pixels << endl;
+			//÷ ؼ   ٰ ڽ  ħ
+			InBoxChecker_Tool.DrawBoxes(&detectedFrame, InBoxChecker::ColorDetection);
 
+			//÷ ؼǱ  
+			cv::imshow("colorDetectedWithMedianBlur Result", detectedFrame);
+			cv::imwrite("./imwrite_imgs/colorDetectedWithMedianBlur_Result.jpg", detectedFrame);
+			if (cv::waitKey(0) == 27);
 
-		//÷ ؼ   ٰ ڽ  ħ
-		InBoxChecker_Tool.DrawBoxes(&detectedFrame, InBoxChecker::ColorDetection);
+			//break;
+			cv::Mat back_sample = cv::imread("./autoColorParameters/autoColorParameter_fig_test/Rust/Background/ ǱԾ  1.png");
+			cv::Mat color_sample = cv::imread("./autoColorParameters/autoColorParameter_fig_test/Rust/ColorArea/÷ ǱԾ  1.png");
 
-		//÷ ؼǱ  
-		cv::imshow("colorDetectedWithMedianBlur Result", detectedFrame);
-		cv::imwrite("./imwrite_imgs/colorDetectedWithMedianBlur_Result.jpg", detectedFrame);
-		if (cv::waitKey(0) == 27);
+			calcHistAndDislay(&back_sample);
+			calcHistAndDislay(&color_sample);
 
-		//break;
-		cv::Mat back_sample = cv::imread("./autoColorParameters/autoColorParameter_fig_test/Rust/Background/ ǱԾ  1.png");
-		cv::Mat color_sample = cv::imread("./autoColorParameters/autoColorParameter_fig_test/Rust/ColorArea/÷ ǱԾ  1.png");
+			//׷̽ ⿡   Ѽ   
+			LatencyGovernor_Tool.BeginStage(LatencyGovernor::Stage_GrayScale);
+			res = GrayScale_Module.CalcGrayScale(frame, &InBoxChecker_Tool);
+			LatencyGovernor_Tool.EndStage(LatencyGovernor::Stage_GrayScale);
+			cout << "cur grayscale : " << res << endl;
 
-		calcHistAndDislay(&back_sample);
-		calcHistAndDislay(&color_sample);
+			// ӿ   ֵ  
+			FrameChangeGate_Tool.StoreResults(&InBoxChecker_Tool, detected_pixels, res);
 
-		//׷̽ ⿡   Ѽ   
-		float res = GrayScale_Module.CalcGrayScale(frame, &InBoxChecker_Tool);
-		cout << "cur grayscale : " << res << endl;
+			//ó ð    ǰ ܰ踦 Ѵ
+			LatencyGovernor_Tool.EndFrame(&YOLO_v3_Module, &ColorDetection_Module);
+		}
+		else
+		{
+			FrameChangeGate_Tool.RestoreResults(&InBoxChecker_Tool, &detected_pixels, &res);
+			InBoxChecker_Tool.DrawBoxes(&detectedFrame, InBoxChecker::YOLOv3);
+			InBoxChecker_Tool.DrawBoxes(&detectedFrame, InBoxChecker::ColorDetection);
+			cv::imshow("colorDetectedWithMedianBlur Result", detectedFrame);
+			cout << "static frame, cached grayscale : " << res << " / skipped : " << FrameChangeGate_Tool.GetSkippedFrameCount()
+				<< " / processed : " << FrameChangeGate_Tool.GetProcessedFrameCount() << endl;
+		}
 
 		//콺 ݹ Լ 
 		cv::setMouseCallback("original", CallBackFunc, NULL);